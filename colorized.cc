@@ -0,0 +1,22 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+// non-template core of colorized, built once for COLORIZED_COMPILED_LIB users.
+#if !defined(COLORIZED_COMPILED_LIB)
+#error "colorized.cc is only needed with COLORIZED_COMPILED_LIB, header only users just include the headers"
+#endif
+
+#define COLORIZED_COMPILING_LIB
+
+#include "colorized.hh"
+#include "colorized_color.hh"
+#include "colorized_gradient.hh"
+#include "colorized_html.hh"
+#include "colorized_layout.hh"
+#include "colorized_live.hh"
+#include "colorized_record.hh"
+#include "colorized_styled_string.hh"
+#include "colorized_unicode.hh"
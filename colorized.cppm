@@ -0,0 +1,200 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+// `import colorized;` instead of including the headers. the headers are parsed once when this
+// interface is built, importers only load the compiled module. the same names as the headers
+// are exported, detail namespaces stay behind. build it through the cmake option
+// COLORIZED_BUILD_MODULE, which also links the non-template core from colorized.cc.
+module;
+
+#include "colorized.hh"
+#include "colorized_color.hh"
+#include "colorized_gradient.hh"
+#include "colorized_html.hh"
+#include "colorized_layout.hh"
+#include "colorized_live.hh"
+#include "colorized_record.hh"
+#include "colorized_styled_string.hh"
+#include "colorized_unicode.hh"
+
+export module colorized;
+
+export namespace colorized {
+using colorized::Style;
+using enum colorized::Style;
+using colorized::_4BitForeground;
+using enum colorized::_4BitForeground;
+using colorized::_4BitBackground;
+using enum colorized::_4BitBackground;
+using colorized::_8BitColor;
+using enum colorized::_8BitColor;
+using colorized::Foreground;
+using colorized::Background;
+using colorized::_RGBA;
+using colorized::RGBA;
+
+using colorized::Outputable;
+using colorized::Inputable;
+using colorized::InorOutable;
+using colorized::Arithmetic;
+using colorized::IsOstream;
+using colorized::IsIstream;
+using colorized::IsStream;
+using colorized::IsOstreamType;
+using colorized::IsIstreamType;
+using colorized::IsStreamType;
+
+using colorized::Pack;
+using colorized::print;
+using colorized::print_cout;
+using colorized::print_cerr;
+using colorized::print_format;
+using colorized::print_cout_format;
+using colorized::print_cerr_format;
+using colorized::print_formats_recursive;
+using colorized::print_cout_reset;
+using colorized::print_cerr_reset;
+
+using colorized::ColorKind;
+using colorized::Color;
+using colorized::Attributes;
+using colorized::Styled;
+using colorized::Modifier;
+using colorized::ForegroundColor;
+using colorized::BackgroundColor;
+using colorized::style;
+using colorized::fg;
+using colorized::bg;
+using colorized::rgb;
+using colorized::on_rgb;
+using colorized::bold;
+using colorized::dim;
+using colorized::italic;
+using colorized::underline;
+using colorized::blink;
+using colorized::operator<<;
+using colorized::render_to;
+using colorized::AnsiDecoder;
+
+using colorized::GradientUnit;
+using colorized::GradientOptions;
+using colorized::render_gradient;
+using colorized::print_gradient;
+using colorized::print_gradient_cout;
+using colorized::print_gradient_cerr;
+
+using colorized::StyledString;
+
+namespace runtime {
+using colorized::runtime::generate_colors;
+} // namespace runtime
+
+namespace constants {
+using colorized::constants::black_color;
+using colorized::constants::red_color;
+using colorized::constants::green_color;
+using colorized::constants::yellow_color;
+using colorized::constants::blue_color;
+using colorized::constants::magenta_color;
+using colorized::constants::cyan_color;
+using colorized::constants::white_color;
+using colorized::constants::light_black_color;
+using colorized::constants::light_red_color;
+using colorized::constants::light_green_color;
+using colorized::constants::light_yellow_color;
+using colorized::constants::light_blue_color;
+using colorized::constants::light_magenta_color;
+using colorized::constants::light_cyan_color;
+using colorized::constants::light_white_color;
+using colorized::constants::bold_black_color;
+using colorized::constants::bold_red_color;
+using colorized::constants::bold_green_color;
+using colorized::constants::bold_yellow_color;
+using colorized::constants::bold_blue_color;
+using colorized::constants::bold_magenta_color;
+using colorized::constants::bold_cyan_color;
+using colorized::constants::bold_white_color;
+using colorized::constants::light_bold_black_color;
+using colorized::constants::light_bold_red_color;
+using colorized::constants::light_bold_green_color;
+using colorized::constants::light_bold_yellow_color;
+using colorized::constants::light_bold_blue_color;
+using colorized::constants::light_bold_magenta_color;
+using colorized::constants::light_bold_cyan_color;
+using colorized::constants::light_bold_white_color;
+using colorized::constants::reset_color;
+} // namespace constants
+
+namespace color {
+using colorized::color::Hsl;
+using colorized::color::Hsv;
+using colorized::color::OkLab;
+using colorized::color::Planes;
+using colorized::color::MutablePlanes;
+using colorized::color::ConstPlanes;
+using colorized::color::to_hsl;
+using colorized::color::from_hsl;
+using colorized::color::to_hsv;
+using colorized::color::from_hsv;
+using colorized::color::to_oklab;
+using colorized::color::from_oklab;
+using colorized::color::luminance;
+using colorized::color::contrast_ratio;
+using colorized::color::blend;
+using colorized::color::blend_oklab;
+using colorized::color::readable_on;
+using colorized::color::gradient;
+using colorized::color::heat;
+using colorized::color::ColorDepth;
+using colorized::color::to_indexed;
+using colorized::color::to_basic;
+using colorized::color::downsample;
+} // namespace color
+
+namespace html {
+using colorized::html::Options;
+using colorized::html::Converter;
+using colorized::html::convert;
+} // namespace html
+
+namespace layout {
+using colorized::layout::Align;
+using colorized::layout::Overflow;
+using colorized::layout::width;
+using colorized::layout::fit;
+using colorized::layout::truncate;
+using colorized::layout::wrap;
+using colorized::layout::write_padded;
+using colorized::layout::Column;
+using colorized::layout::Table;
+} // namespace layout
+
+namespace live {
+using colorized::live::BarStyle;
+using colorized::live::Bar;
+using colorized::live::Region;
+} // namespace live
+
+namespace record {
+using colorized::record::magic;
+using colorized::record::Tag;
+using enum colorized::record::Tag;
+using colorized::record::Recorder;
+using colorized::record::replay;
+using colorized::record::replay_to;
+} // namespace record
+
+namespace unicode {
+using colorized::unicode::replacement_character;
+using colorized::unicode::next;
+using colorized::unicode::is_extending;
+using colorized::unicode::is_regional_indicator;
+using colorized::unicode::next_grapheme;
+using colorized::unicode::width;
+using colorized::unicode::grapheme_width;
+using colorized::unicode::display_width;
+} // namespace unicode
+} // namespace colorized
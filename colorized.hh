@@ -6,12 +6,18 @@
 
 #pragma once
 
+#include "colorized_config.hh"
 #include <iostream>
 #include <type_traits>
 #include <format>
 #include <string_view>
 #include <string>
 #include <cstdint>
+#include <charconv>
+#include <iterator>
+#include <cstring>
+#include <array>
+#include <functional>
 
 namespace colorized {
 enum Style: std::uint8_t {
@@ -118,24 +124,25 @@ using Background = _4BitBackground;
 
 namespace detail {
 template<typename... Args>
-static constexpr auto format_generate_str(std::string_view context, Args&&... args) noexcept {
+constexpr auto format_generate_str(std::string_view context, Args&&... args) noexcept {
   return std::vformat(context, std::make_format_args(args...));
 }
 } // namespace detail
 
 template<typename _Style, typename Stream, typename T>
-static constexpr void print(_Style style, Foreground foreground, Background background, Stream& stream, T&& t) noexcept;
+constexpr void print(_Style style, Foreground foreground, Background background, Stream& stream, T&& t) noexcept;
 
 template<typename _Style, typename Stream, typename T>
-static constexpr void print(_Style style, RGBA foreground, RGBA background, Stream& stream, T&& t) noexcept;
+constexpr void print(_Style style, RGBA foreground, RGBA background, Stream& stream, T&& t) noexcept;
 
 template<typename _Style, typename Stream, typename T>
-static constexpr void print(_Style style, _8BitColor foreground, _8BitColor background, Stream& stream, T&& t) noexcept;
+constexpr void print(_Style style, _8BitColor foreground, _8BitColor background, Stream& stream, T&& t) noexcept;
 
 template<Arithmetic T>
 struct _RGBA {
   T r, g, b;
-  constexpr _RGBA(T r, T b, T g) : r{r}, g{g}, b{b} {}
+  constexpr _RGBA(T r, T g, T b) : r{r}, g{g}, b{b} {}
+  constexpr bool operator==(const _RGBA&) const noexcept = default;
 };
 
 template<typename _Style, typename _Foreground, typename _Background, typename Str, typename... InArgs>
@@ -148,7 +155,7 @@ struct Pack {
 
 // we don't need to mark `constexpr` since std::cout is runtime operation, but why not?
 template<typename _Style, typename Stream, typename T>
-static constexpr void print(_Style style, Foreground foreground, Background background, Stream& stream, T&& t) noexcept {
+constexpr void print(_Style style, Foreground foreground, Background background, Stream& stream, T&& t) noexcept {
   if constexpr(std::is_same_v<IsOstreamType<Stream, T>, std::true_type>) {
     stream << "\x1b[0m\x1b[" << +style << ";" << +background << "m"
           << "\x1b[" << +style << ";" << +foreground << "m"
@@ -159,7 +166,7 @@ static constexpr void print(_Style style, Foreground foreground, Background back
 }
 
 template<typename _Style, typename Stream, typename T>
-static constexpr void print(_Style style, RGBA foreground, RGBA background, Stream& stream, T&& t) noexcept {
+constexpr void print(_Style style, RGBA foreground, RGBA background, Stream& stream, T&& t) noexcept {
   if constexpr(std::is_same_v<IsOstreamType<Stream, T>, std::true_type>) {
     stream << "\x1b[0m\x1b[" << +style << ";49m"
            << "\x1b[48;2;" << +background.r << ";" << +background.g << ";" << +background.b << "m"
@@ -171,7 +178,7 @@ static constexpr void print(_Style style, RGBA foreground, RGBA background, Stre
 }
 
 template<typename _Style, typename Stream, typename T>
-static constexpr void print(_Style style, _8BitColor foreground, _8BitColor background, Stream& stream, T&& t) noexcept {
+constexpr void print(_Style style, _8BitColor foreground, _8BitColor background, Stream& stream, T&& t) noexcept {
   if constexpr(std::is_same_v<IsOstreamType<Stream, T>, std::true_type>) {
     stream << "\x1b[0m\x1b[" << +style << ";49m"
            << "\x1b[48;5;" << +background << "m"
@@ -183,27 +190,27 @@ static constexpr void print(_Style style, _8BitColor foreground, _8BitColor back
 }
 
 template<typename _Style, typename _Foreground, typename _Background, typename Str>
-static constexpr void print_cout(_Style style, _Foreground foreground, _Background background, Str&& t) noexcept {
+constexpr void print_cout(_Style style, _Foreground foreground, _Background background, Str&& t) noexcept {
   print(style, foreground, background, std::cout, std::forward<Str>(t));
 }
 
 template<typename _Style, typename _Foreground, typename _Background, typename Str>
-static constexpr void print_cerr(_Style style, _Foreground foreground, _Background background, Str&& t) noexcept {
+constexpr void print_cerr(_Style style, _Foreground foreground, _Background background, Str&& t) noexcept {
   print(style, foreground, background, std::cerr, std::forward<Str>(t));
 }
 
 template<typename _Style, typename _Foreground, typename _Background, typename Stream, typename Str, typename... Args>
-static constexpr void print_format(_Style style, _Foreground foreground, _Background background, Stream& stream, Str ctx, Args&&... args) noexcept {
+constexpr void print_format(_Style style, _Foreground foreground, _Background background, Stream& stream, Str ctx, Args&&... args) noexcept {
   colorized::print(style, foreground, background, stream, detail::format_generate_str(ctx, std::forward<Args>(args)...));
 }
 
 template<typename _Style, typename _Foreground, typename _Background, typename Str, typename... Args>
-static constexpr void print_cout_format(_Style style, _Foreground foreground, _Background background, Str ctx, Args&&... args) noexcept {
+constexpr void print_cout_format(_Style style, _Foreground foreground, _Background background, Str ctx, Args&&... args) noexcept {
   colorized::print_format(style, foreground, background, std::cout, detail::format_generate_str(ctx, std::forward<Args>(args)...));
 }
 
 template<typename _Style, typename _Foreground, typename _Background, typename Str, typename... Args>
-static constexpr void print_cerr_format(_Style style, _Foreground foreground, _Background background, Str ctx, Args&&... args) noexcept {
+constexpr void print_cerr_format(_Style style, _Foreground foreground, _Background background, Str ctx, Args&&... args) noexcept {
   colorized::print_format(style, foreground, background, std::cout, detail::format_generate_str(ctx, std::forward<Args>(args)...));
 }
 
@@ -225,83 +232,561 @@ constexpr void print_formats_recursive(Args&&... args) noexcept {
   (detail::handle_one_pack(std::forward<Args>(args)), ...);
 }
 
-// there is no known macro for C++23
-#if __cplusplus > 202002L
-static constexpr void print_cout_reset() noexcept
-#else
-  static void print_cout_reset() noexcept
-#endif
-{
-  std::cout << "\x1b[0m";
+COLORIZED_INLINE void print_cout_reset() noexcept;
+COLORIZED_INLINE void print_cerr_reset() noexcept;
+
+namespace runtime {
+[[nodiscard]] COLORIZED_INLINE std::string generate_colors(Style style, Foreground fg, Background bg) noexcept;
+
+[[nodiscard]] COLORIZED_INLINE std::string generate_colors(Style style, RGBA fg, RGBA bg) noexcept;
+
+[[nodiscard]] COLORIZED_INLINE std::string generate_colors(Style style, _8BitColor fg, _8BitColor bg) noexcept;
+} // namespace runtime
+
+namespace constants {
+// those constants are sometimes useful for quickly test something.
+inline constexpr std::string_view black_color { "\x1b[0;30m" };
+inline constexpr std::string_view red_color { "\x1b[0;31m" };
+inline constexpr std::string_view green_color { "\x1b[0;32m" };
+inline constexpr std::string_view yellow_color { "\x1b[0;33m" };
+inline constexpr std::string_view blue_color { "\x1b[0;34m" };
+inline constexpr std::string_view magenta_color { "\x1b[0;35m" };
+inline constexpr std::string_view cyan_color { "\x1b[0;36m" };
+inline constexpr std::string_view white_color { "\x1b[0;37m" };
+inline constexpr std::string_view light_black_color { "\x1b[0;90m" };
+inline constexpr std::string_view light_red_color { "\x1b[0;91m" };
+inline constexpr std::string_view light_green_color { "\x1b[0;92m" };
+inline constexpr std::string_view light_yellow_color { "\x1b[0;93m" };
+inline constexpr std::string_view light_blue_color { "\x1b[0;94m" };
+inline constexpr std::string_view light_magenta_color { "\x1b[0;95m" };
+inline constexpr std::string_view light_cyan_color { "\x1b[0;96m" };
+inline constexpr std::string_view light_white_color { "\x1b[0;97m" };
+
+inline constexpr std::string_view bold_black_color { "\x1b[1;30m" };
+inline constexpr std::string_view bold_red_color { "\x1b[1;31m" };
+inline constexpr std::string_view bold_green_color { "\x1b[1;32m" };
+inline constexpr std::string_view bold_yellow_color { "\x1b[01;33m" };
+inline constexpr std::string_view bold_blue_color { "\x1b[1;34m" };
+inline constexpr std::string_view bold_magenta_color { "\x1b[1;35m" };
+inline constexpr std::string_view bold_cyan_color { "\x1b[1;36m" };
+inline constexpr std::string_view bold_white_color { "\x1b[1;37m" };
+inline constexpr std::string_view light_bold_black_color { "\x1b[1;90m" };
+inline constexpr std::string_view light_bold_red_color { "\x1b[1;91m" };
+inline constexpr std::string_view light_bold_green_color { "\x1b[1;92m" };
+inline constexpr std::string_view light_bold_yellow_color { "\x1b[1;93m" };
+inline constexpr std::string_view light_bold_blue_color { "\x1b[1;94m" };
+inline constexpr std::string_view light_bold_magenta_color { "\x1b[1;95m" };
+inline constexpr std::string_view light_bold_cyan_color { "\x1b[1;96m" };
+inline constexpr std::string_view light_bold_white_color { "\x1b[1;97m" };
+
+inline constexpr std::string_view reset_color { "\x1b[0m" };
+} // namespace constants
+
+// tagged color slot, so 4-bit, 8-bit and truecolor values can share one attribute set.
+enum class ColorKind : std::uint8_t {
+  Unset,   // inherits whatever is active
+  Basic,   // 4-bit SGR code (30-37, 90-97, 40-47, 100-107, 39, 49)
+  Indexed, // 256 color palette index
+  Direct   // 24-bit truecolor
+};
+
+struct Color {
+  ColorKind kind { ColorKind::Unset };
+  // Basic keeps its SGR code in `r`, Indexed keeps its palette index in `r`.
+  std::uint8_t r {}, g {}, b {};
+
+  constexpr Color() noexcept = default;
+  constexpr Color(Foreground fg) noexcept : kind{ColorKind::Basic}, r{fg} {}
+  constexpr Color(Background bg) noexcept : kind{ColorKind::Basic}, r{bg} {}
+  constexpr Color(_8BitColor color) noexcept : kind{ColorKind::Indexed}, r{color} {}
+  constexpr Color(RGBA color) noexcept : kind{ColorKind::Direct}, r{color.r}, g{color.g}, b{color.b} {}
+  constexpr Color(std::uint8_t r, std::uint8_t g, std::uint8_t b) noexcept : kind{ColorKind::Direct}, r{r}, g{g}, b{b} {}
+
+  [[nodiscard]] constexpr bool is_set() const noexcept { return kind != ColorKind::Unset; }
+
+  // same color as truecolor, resolved through the xterm default palette; default colors stay unset.
+  [[nodiscard]] constexpr Color direct() const noexcept;
+
+  constexpr bool operator==(const Color&) const noexcept = default;
+};
+
+// style bits plus foreground and background, everything one SGR sequence can carry.
+struct Attributes {
+  std::uint8_t styles {}; // bit (1 << Style) for every enabled style, Standard is ignored.
+  Color foreground {}, background {};
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return (styles & ~1u) == 0 && !foreground.is_set() && !background.is_set();
+  }
+
+  [[nodiscard]] constexpr bool has(Style style) const noexcept {
+    return (styles >> style) & 1u;
+  }
+
+  // nested attributes win: styles accumulate, inner colors override outer ones.
+  [[nodiscard]] constexpr Attributes merge(const Attributes& inner) const noexcept {
+    return {
+      static_cast<std::uint8_t>(styles | inner.styles),
+      inner.foreground.is_set() ? inner.foreground : foreground,
+      inner.background.is_set() ? inner.background : background
+    };
+  }
+
+  constexpr bool operator==(const Attributes&) const noexcept = default;
+};
+
+namespace detail {
+// xterm default palette: 16 system colors, 6x6x6 cube, then 24 grays.
+[[nodiscard]] constexpr Color palette(std::uint8_t index) noexcept {
+  constexpr std::uint8_t system[16][3] {
+    {0x00, 0x00, 0x00}, {0xcd, 0x00, 0x00}, {0x00, 0xcd, 0x00}, {0xcd, 0xcd, 0x00},
+    {0x00, 0x00, 0xee}, {0xcd, 0x00, 0xcd}, {0x00, 0xcd, 0xcd}, {0xe5, 0xe5, 0xe5},
+    {0x7f, 0x7f, 0x7f}, {0xff, 0x00, 0x00}, {0x00, 0xff, 0x00}, {0xff, 0xff, 0x00},
+    {0x5c, 0x5c, 0xff}, {0xff, 0x00, 0xff}, {0x00, 0xff, 0xff}, {0xff, 0xff, 0xff}
+  };
+  constexpr std::uint8_t cube[6] { 0, 95, 135, 175, 215, 255 };
+
+  if(index < 16)
+    return {system[index][0], system[index][1], system[index][2]};
+
+  if(index < 232) {
+    const int i = index - 16;
+    return {cube[i / 36], cube[i / 6 % 6], cube[i % 6]};
+  }
+
+  const auto gray = static_cast<std::uint8_t>(8 + (index - 232) * 10);
+  return {gray, gray, gray};
 }
 
-#if __cplusplus > 202002L
-static constexpr void print_cout_reset() noexcept
-#else
-  static void print_cerr_reset() noexcept
-#endif
-{
-  std::cerr << "\x1b[0m";
+// applies one SGR parameter list (already split on ';') to an attribute set.
+constexpr void apply_sgr(Attributes& attributes, const std::uint16_t* params, std::size_t count) noexcept {
+  const auto channel = [](std::uint16_t n) { return static_cast<std::uint8_t>(n > 255 ? 255 : n); };
+
+  for(std::size_t i = 0; i < count; ++i) {
+    const auto code = params[i];
+
+    if(code == 0) {
+      attributes = {};
+    } else if(code >= Bold && code <= Blink) {
+      attributes.styles |= static_cast<std::uint8_t>(1u << code);
+    } else if(code == 21 || code == 22) {
+      attributes.styles &= static_cast<std::uint8_t>(~((1u << Bold) | (1u << Dim)));
+    } else if(code >= 23 && code <= 25) {
+      attributes.styles &= static_cast<std::uint8_t>(~(1u << (code - 20)));
+    } else if((code >= FgBlack && code <= FgWhite) || (code >= FgBrBlack && code <= FgBrWhite)) {
+      attributes.foreground = Color{static_cast<Foreground>(code)};
+    } else if((code >= BgBlack && code <= BgWhite) || (code >= BgBrBlack && code <= BgBrWhite)) {
+      attributes.background = Color{static_cast<Background>(code)};
+    } else if(code == FgDefault) {
+      attributes.foreground = {};
+    } else if(code == BgDefault) {
+      attributes.background = {};
+    } else if(code == 38 || code == 48) {
+      auto& slot = code == 38 ? attributes.foreground : attributes.background;
+
+      if(i + 2 < count && params[i + 1] == 5) {
+        slot = Color{static_cast<_8BitColor>(channel(params[i + 2]))};
+        i += 2;
+      } else if(i + 4 < count && params[i + 1] == 2) {
+        slot = Color{channel(params[i + 2]), channel(params[i + 3]), channel(params[i + 4])};
+        i += 4;
+      } else {
+        return; // malformed extended color, the rest can't be trusted.
+      }
+    }
+  }
 }
 
-namespace runtime {
-[[nodiscard]] static std::string generate_colors(Style style, Foreground fg, Background bg) noexcept {
-  return "\x1b[" + std::to_string(style) + ";" + std::to_string(bg) + "m\x1b[" + std::to_string(style) + ";" + std::to_string(fg) + "m";
+// fixed-size scratch for a single SGR sequence, large enough for every style plus two truecolor slots.
+struct SequenceBuffer {
+  char data[80] {};
+  std::size_t size {};
+
+  constexpr void push(char c) noexcept { data[size++] = c; }
+
+  constexpr void push(std::string_view str) noexcept {
+    for(char c : str)
+      push(c);
+  }
+
+  constexpr void push_number(std::uint8_t n) noexcept {
+    if(n >= 100) push(static_cast<char>('0' + n / 100));
+    if(n >= 10) push(static_cast<char>('0' + n / 10 % 10));
+    push(static_cast<char>('0' + n % 10));
+  }
+
+  // starts the sequence on first parameter, separates the rest with ';'.
+  constexpr void parameter(std::uint8_t n) noexcept {
+    push(size == 0 ? std::string_view{"\x1b["} : std::string_view{";"});
+    push_number(n);
+  }
+
+  constexpr void color(const Color& color, bool background) noexcept {
+    switch(color.kind) {
+      case ColorKind::Unset: break;
+      case ColorKind::Basic: parameter(color.r); break;
+      case ColorKind::Indexed: {
+        parameter(background ? 48 : 38); parameter(5); parameter(color.r);
+        break;
+      }
+      case ColorKind::Direct: {
+        parameter(background ? 48 : 38); parameter(2);
+        parameter(color.r); parameter(color.g); parameter(color.b);
+        break;
+      }
+    }
+  }
+
+  constexpr SequenceBuffer& finish() noexcept {
+    if(size != 0) push('m');
+    return *this;
+  }
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept { return {data, size}; }
+};
+
+// whole attribute set as one sequence, empty when there is nothing to set.
+[[nodiscard]] constexpr SequenceBuffer sequence(const Attributes& attributes) noexcept {
+  SequenceBuffer buffer;
+  for(std::uint8_t style = Bold; style <= Blink; ++style)
+    if(attributes.has(static_cast<Style>(style)))
+      buffer.parameter(style);
+  buffer.color(attributes.background, true);
+  buffer.color(attributes.foreground, false);
+  return buffer.finish();
 }
 
-[[nodiscard]] static std::string generate_colors(Style style, RGBA fg, RGBA bg) noexcept {
-  return "\x1b[" + std::to_string(style) + ";49m\x1b[48;2;" + std::to_string(bg.r) + ";" + std::to_string(bg.g) + ";" + std::to_string(bg.b) + "m" +
-         "\x1b[38;2;" + std::to_string(fg.r) + ";" + std::to_string(fg.g) + ";" + std::to_string(fg.b) + "m";
+// smallest sequence that takes a terminal from `from` to `to`, empty when nothing changes.
+[[nodiscard]] constexpr SequenceBuffer transition(const Attributes& from, const Attributes& to) noexcept {
+  SequenceBuffer buffer;
+  if(from == to)
+    return buffer;
+
+  if(to.empty()) {
+    buffer.push(constants::reset_color);
+    return buffer;
+  }
+
+  const auto bit = [](Style style) { return static_cast<std::uint8_t>(1u << style); };
+  const std::uint8_t removed = from.styles & ~to.styles;
+  std::uint8_t added = to.styles & ~from.styles;
+
+  // 22 turns off bold and dim together, whichever of them stays has to come back.
+  if(removed & (bit(Bold) | bit(Dim))) {
+    buffer.parameter(22);
+    added |= to.styles & (bit(Bold) | bit(Dim));
+  }
+  if(removed & bit(Italic)) buffer.parameter(23);
+  if(removed & bit(Underline)) buffer.parameter(24);
+  if(removed & bit(Blink)) buffer.parameter(25);
+
+  for(std::uint8_t style = Bold; style <= Blink; ++style)
+    if(added & (1u << style))
+      buffer.parameter(style);
+
+  if(from.background != to.background) {
+    if(to.background.is_set()) buffer.color(to.background, true);
+    else buffer.parameter(BgDefault);
+  }
+
+  if(from.foreground != to.foreground) {
+    if(to.foreground.is_set()) buffer.color(to.foreground, false);
+    else buffer.parameter(FgDefault);
+  }
+  return buffer.finish();
 }
 
-[[nodiscard]] static std::string generate_colors(Style style, _8BitColor fg, _8BitColor bg) noexcept {
-  return "\x1b[0m" + std::to_string(style) + ";49m\x1b[48;5;" + std::to_string(bg) + "m" +
-         "\x1b[38;5;" + std::to_string(fg) + "m";
+template<typename Out>
+constexpr Out copy_to(Out out, std::string_view str) noexcept {
+  for(char c : str)
+    *out++ = c;
+  return out;
 }
-} // namespace runtime
 
-namespace constants {
-// those constants are sometimes useful for quickly test something.
-static constexpr std::string_view black_color { "\x1b[0;30m" };
-static constexpr std::string_view red_color { "\x1b[0;31m" };
-static constexpr std::string_view green_color { "\x1b[0;32m" };
-static constexpr std::string_view yellow_color { "\x1b[0;33m" };
-static constexpr std::string_view blue_color { "\x1b[0;34m" };
-static constexpr std::string_view magenta_color { "\x1b[0;35m" };
-static constexpr std::string_view cyan_color { "\x1b[0;36m" };
-static constexpr std::string_view white_color { "\x1b[0;37m" };
-static constexpr std::string_view light_black_color { "\x1b[0;90m" };
-static constexpr std::string_view light_red_color { "\x1b[0;91m" };
-static constexpr std::string_view light_green_color { "\x1b[0;92m" };
-static constexpr std::string_view light_yellow_color { "\x1b[0;93m" };
-static constexpr std::string_view light_blue_color { "\x1b[0;94m" };
-static constexpr std::string_view light_magenta_color { "\x1b[0;95m" };
-static constexpr std::string_view light_cyan_color { "\x1b[0;96m" };
-static constexpr std::string_view light_white_color { "\x1b[0;97m" };
-
-static constexpr std::string_view bold_black_color { "\x1b[1;30m" };
-static constexpr std::string_view bold_red_color { "\x1b[1;31m" };
-static constexpr std::string_view bold_green_color { "\x1b[1;32m" };
-static constexpr std::string_view bold_yellow_color { "\x1b[01;33m" };
-static constexpr std::string_view bold_blue_color { "\x1b[1;34m" };
-static constexpr std::string_view bold_magenta_color { "\x1b[1;35m" };
-static constexpr std::string_view bold_cyan_color { "\x1b[1;36m" };
-static constexpr std::string_view bold_white_color { "\x1b[1;37m" };
-static constexpr std::string_view light_bold_black_color { "\x1b[1;90m" };
-static constexpr std::string_view light_bold_red_color { "\x1b[1;91m" };
-static constexpr std::string_view light_bold_green_color { "\x1b[1;92m" };
-static constexpr std::string_view light_bold_yellow_color { "\x1b[1;93m" };
-static constexpr std::string_view light_bold_blue_color { "\x1b[1;94m" };
-static constexpr std::string_view light_bold_magenta_color { "\x1b[1;95m" };
-static constexpr std::string_view light_bold_cyan_color { "\x1b[1;96m" };
-static constexpr std::string_view light_bold_white_color { "\x1b[1;97m" };
-
-static constexpr std::string_view reset_color { "\x1b[0m" };
-} // namespace constants
+// writes a value into an output iterator without going through a stream. the bytes match
+// what operator<< on an ostream gives, so signed and unsigned char are characters too.
+// bool is the exception: it's "true"/"false" like std::format, a stream follows its boolalpha flag.
+template<typename Out, typename T>
+Out write_value(Out out, const T& value) noexcept {
+  if constexpr(std::is_convertible_v<const T&, std::string_view>) {
+    return copy_to(out, std::string_view{value});
+  } else if constexpr(std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+    *out++ = static_cast<char>(value);
+    return out;
+  } else if constexpr(std::is_same_v<T, bool>) {
+    return copy_to(out, value ? "true" : "false");
+  } else if constexpr(Arithmetic<T>) {
+    char buffer[64];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof buffer, value);
+    return copy_to(out, std::string_view{buffer, static_cast<std::size_t>(end - buffer)});
+  } else {
+    return std::format_to(out, "{}", value);
+  }
+}
+} // namespace detail
+
+constexpr Color Color::direct() const noexcept {
+  switch(kind) {
+    case ColorKind::Basic: {
+      const std::uint8_t code = (r >= BgBlack && r <= BgDefault) || r >= BgBrBlack ? r - 10 : r; // background codes are +10
+      if(code >= FgBlack && code <= FgWhite) return detail::palette(code - FgBlack);
+      if(code >= FgBrBlack && code <= FgBrWhite) return detail::palette(code - FgBrBlack + 8);
+      return {};
+    }
+    case ColorKind::Indexed: return detail::palette(r);
+    default: return *this;
+  }
+}
+
+// lazily styled value; nothing is generated until it's inserted into a stream, formatted or rendered.
+// lvalues are held by reference, temporaries are moved in.
+template<typename T>
+struct Styled {
+  using value_type = T;
+
+  Attributes attributes;
+  T value;
+};
+
+// attribute set waiting for a value, e.g. rgb(255, 0, 0)("hi") or (style(Bold) | fg(FgRed))(value).
+struct Modifier {
+  Attributes attributes;
+
+  template<typename T>
+  [[nodiscard]] constexpr auto operator()(T&& value) const noexcept;
+
+  [[nodiscard]] constexpr Modifier operator|(const Modifier& inner) const noexcept {
+    return {attributes.merge(inner.attributes)};
+  }
+};
+
+template<typename C>
+concept ForegroundColor = std::is_same_v<C, Foreground> || std::is_same_v<C, _8BitColor> || std::is_same_v<C, RGBA>;
+
+template<typename C>
+concept BackgroundColor = std::is_same_v<C, Background> || std::is_same_v<C, _8BitColor> || std::is_same_v<C, RGBA>;
+
+namespace detail {
+template<typename T>
+struct is_styled : std::false_type {};
+
+template<typename T>
+struct is_styled<Styled<T>> : std::true_type {};
+
+// wrapping an already styled value folds both attribute sets, so nesting never adds a layer.
+template<typename T>
+constexpr auto apply_attributes(const Attributes& attributes, T&& value) noexcept {
+  using U = std::remove_cvref_t<T>;
+
+  if constexpr(std::is_same_v<U, Modifier>) {
+    return Modifier{attributes.merge(value.attributes)};
+  } else if constexpr(is_styled<U>::value) {
+    using Inner = typename U::value_type;
+
+    if constexpr(std::is_reference_v<Inner> || std::is_rvalue_reference_v<T&&>) {
+      return Styled<Inner>{attributes.merge(value.attributes), std::forward<T>(value).value};
+    } else {
+      return Styled<const Inner&>{attributes.merge(value.attributes), value.value};
+    }
+  } else if constexpr(std::is_lvalue_reference_v<T>) {
+    return Styled<const U&>{attributes, value};
+  } else {
+    return Styled<U>{attributes, std::forward<T>(value)};
+  }
+}
+} // namespace detail
+
+template<typename T>
+constexpr auto Modifier::operator()(T&& value) const noexcept {
+  return detail::apply_attributes(attributes, std::forward<T>(value));
+}
+
+[[nodiscard]] constexpr Modifier style(Style style) noexcept {
+  return {{static_cast<std::uint8_t>(1u << style)}};
+}
+
+template<ForegroundColor C>
+[[nodiscard]] constexpr Modifier fg(C color) noexcept {
+  return {{0, Color{color}}};
+}
+
+template<BackgroundColor C>
+[[nodiscard]] constexpr Modifier bg(C color) noexcept {
+  return {{0, {}, Color{color}}};
+}
+
+[[nodiscard]] constexpr Modifier rgb(std::uint8_t r, std::uint8_t g, std::uint8_t b) noexcept {
+  return {{0, Color{r, g, b}}};
+}
+
+[[nodiscard]] constexpr Modifier on_rgb(std::uint8_t r, std::uint8_t g, std::uint8_t b) noexcept {
+  return {{0, {}, Color{r, g, b}}};
+}
+
+template<typename T>
+[[nodiscard]] constexpr auto style(Style s, T&& value) noexcept {
+  return style(s)(std::forward<T>(value));
+}
+
+template<ForegroundColor C, typename T>
+[[nodiscard]] constexpr auto fg(C color, T&& value) noexcept {
+  return fg(color)(std::forward<T>(value));
+}
+
+template<BackgroundColor C, typename T>
+[[nodiscard]] constexpr auto bg(C color, T&& value) noexcept {
+  return bg(color)(std::forward<T>(value));
+}
+
+template<typename T>
+[[nodiscard]] constexpr auto bold(T&& value) noexcept { return style(Bold, std::forward<T>(value)); }
+
+template<typename T>
+[[nodiscard]] constexpr auto dim(T&& value) noexcept { return style(Dim, std::forward<T>(value)); }
+
+template<typename T>
+[[nodiscard]] constexpr auto italic(T&& value) noexcept { return style(Italic, std::forward<T>(value)); }
+
+template<typename T>
+[[nodiscard]] constexpr auto underline(T&& value) noexcept { return style(Underline, std::forward<T>(value)); }
+
+template<typename T>
+[[nodiscard]] constexpr auto blink(T&& value) noexcept { return style(Blink, std::forward<T>(value)); }
+
+// one combined sequence in front, single reset behind; unstyled values are written as is.
+template<typename Stream, typename T>
+requires requires(Stream& stream, const std::remove_reference_t<T>& value) { stream << value; }
+Stream& operator<<(Stream& stream, const Styled<T>& styled) noexcept {
+  const auto prefix = detail::sequence(styled.attributes);
+
+  if(prefix.size == 0) {
+    stream << styled.value;
+  } else {
+    stream << prefix.view() << styled.value << constants::reset_color;
+  }
+  return stream;
+}
+
+// renders into any char output iterator, no stream or temporary string needed.
+template<std::output_iterator<char> Out, typename T>
+Out render_to(Out out, const Styled<T>& styled) noexcept {
+  const auto prefix = detail::sequence(styled.attributes);
+
+  out = detail::copy_to(out, prefix.view());
+  out = detail::write_value(out, styled.value);
+  return prefix.size == 0 ? out : detail::copy_to(out, constants::reset_color);
+}
+
+template<typename T>
+void render_to(std::string& buffer, const Styled<T>& styled) noexcept {
+  render_to(std::back_inserter(buffer), styled);
+}
+
+// incremental decoder for colored output, the inverse of everything above.
+// input may be split anywhere (even inside a sequence), state carries over between feed calls.
+// SGR sequences update the attribute set, other CSI and OSC sequences are dropped.
+class AnsiDecoder {
+public:
+  // on_text(std::string_view) receives escape-free runs, on_attributes(const Attributes&)
+  // fires whenever a sequence actually changes the active attribute set.
+  template<typename OnText, typename OnAttributes>
+  void feed(std::string_view chunk, OnText&& on_text, OnAttributes&& on_attributes) noexcept {
+    const char* it = chunk.data();
+    const char* const end = it + chunk.size();
+
+    while(it != end) {
+      if(state == State::Ground) {
+        // memchr is vectorized by every libc we care about, text runs never go byte by byte.
+        const auto* escape = static_cast<const char*>(std::memchr(it, '\x1b', static_cast<std::size_t>(end - it)));
+
+        if(escape == nullptr) {
+          on_text(std::string_view{it, static_cast<std::size_t>(end - it)});
+          return;
+        }
+
+        if(escape != it)
+          on_text(std::string_view{it, static_cast<std::size_t>(escape - it)});
+
+        it = escape + 1;
+        state = State::Escape;
+        continue;
+      }
+
+      const auto c = static_cast<unsigned char>(*it++);
+
+      switch(state) {
+        case State::Escape: {
+          if(c == '[') {
+            state = State::Csi;
+            count = 0;
+            params[0] = 0;
+            private_marker = false;
+          } else if(c == ']') {
+            state = State::Osc;
+          } else if(c < 0x20 || c > 0x2f) { // 0x20-0x2f are intermediates, keep waiting for the final byte
+            state = State::Ground;
+          }
+          break;
+        }
+
+        case State::Csi: {
+          if(c >= '0' && c <= '9') {
+            params[count] = static_cast<std::uint16_t>(params[count] > 6552 ? 65535 : params[count] * 10 + (c - '0'));
+          } else if(c == ';' || c == ':') {
+            if(count + 1 < params.size())
+              params[++count] = 0;
+          } else if(c >= 0x3c && c <= 0x3f) {
+            private_marker = true;
+          } else if(c >= 0x40 && c <= 0x7e) {
+            state = State::Ground;
+
+            if(c == 'm' && !private_marker) {
+              const auto previous = active;
+              detail::apply_sgr(active, params.data(), count + 1);
+
+              if(active != previous)
+                on_attributes(active);
+            }
+          } else if(c == 0x1b) {
+            state = State::Escape;
+          }
+          break;
+        }
+
+        case State::Osc: {
+          if(c == '\x07') state = State::Ground;
+          else if(c == 0x1b) state = State::OscEscape;
+          break;
+        }
+
+        case State::OscEscape: {
+          state = State::Ground;
+          break;
+        }
+
+        default: break;
+      }
+    }
+  }
+
+  [[nodiscard]] const Attributes& attributes() const noexcept { return active; }
+
+  // true while a sequence is split across chunks.
+  [[nodiscard]] bool pending() const noexcept { return state != State::Ground; }
+
+private:
+  enum class State : std::uint8_t { Ground, Escape, Csi, Osc, OscEscape };
+
+  State state { State::Ground };
+  bool private_marker { false };
+  std::size_t count {};
+  std::array<std::uint16_t, 32> params {};
+  Attributes active {};
+};
 
 // X11 8 bit color namings
 enum _8BitColor : std::uint8_t {
-  x016_Grey0              ,
+  x016_Grey0 = 16         ,
   x017_NavyBlue           ,
   x018_DarkBlue           ,
   x019_Blue3              ,
@@ -542,4 +1027,54 @@ enum _8BitColor : std::uint8_t {
   x254_Grey89             ,
   x255_Grey93             
 };
-} // namespace colorized
\ No newline at end of file
+} // namespace colorized
+
+// std::format("{}", bold(value)) support, renders the same bytes as render_to.
+template<typename T>
+struct std::formatter<colorized::Styled<T>, char> {
+  constexpr auto parse(std::format_parse_context& ctx) { return ctx.begin(); }
+
+  template<typename FormatContext>
+  auto format(const colorized::Styled<T>& styled, FormatContext& ctx) const {
+    return colorized::render_to(ctx.out(), styled);
+  }
+};
+
+template<>
+struct std::hash<colorized::Attributes> {
+  std::size_t operator()(const colorized::Attributes& attributes) const noexcept {
+    const auto pack = [](const colorized::Color& color) -> std::uint64_t {
+      return static_cast<std::uint64_t>(color.kind) << 24 | color.r << 16 | color.g << 8 | color.b;
+    };
+    const auto key = pack(attributes.foreground) | pack(attributes.background) << 32;
+    return std::hash<std::uint64_t>{}(key ^ attributes.styles * 0x9e3779b97f4a7c15ull);
+  }
+};
+
+#if COLORIZED_DEFINITIONS
+namespace colorized {
+COLORIZED_INLINE void print_cout_reset() noexcept {
+  std::cout << "\x1b[0m";
+}
+
+COLORIZED_INLINE void print_cerr_reset() noexcept {
+  std::cerr << "\x1b[0m";
+}
+
+namespace runtime {
+[[nodiscard]] COLORIZED_INLINE std::string generate_colors(Style style, Foreground fg, Background bg) noexcept {
+  return "\x1b[" + std::to_string(style) + ";" + std::to_string(bg) + "m\x1b[" + std::to_string(style) + ";" + std::to_string(fg) + "m";
+}
+
+[[nodiscard]] COLORIZED_INLINE std::string generate_colors(Style style, RGBA fg, RGBA bg) noexcept {
+  return "\x1b[" + std::to_string(style) + ";49m\x1b[48;2;" + std::to_string(bg.r) + ";" + std::to_string(bg.g) + ";" + std::to_string(bg.b) + "m" +
+         "\x1b[38;2;" + std::to_string(fg.r) + ";" + std::to_string(fg.g) + ";" + std::to_string(fg.b) + "m";
+}
+
+[[nodiscard]] COLORIZED_INLINE std::string generate_colors(Style style, _8BitColor fg, _8BitColor bg) noexcept {
+  return "\x1b[0m" + std::to_string(style) + ";49m\x1b[48;5;" + std::to_string(bg) + "m" +
+         "\x1b[38;5;" + std::to_string(fg) + "m";
+}
+} // namespace runtime
+} // namespace colorized
+#endif // COLORIZED_DEFINITIONS
@@ -0,0 +1,502 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized.hh"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace colorized::color {
+// h in degrees [0, 360), everything else in [0, 1].
+struct Hsl { float h, s, l; };
+struct Hsv { float h, s, v; };
+// L in [0, 1], a and b roughly in [-0.4, 0.4].
+struct OkLab { float L, a, b; };
+
+// structure-of-arrays view over many colors, one contiguous plane per channel.
+// planes of different sizes are used up to the shortest one.
+template<typename T>
+struct Planes {
+  std::span<T> r, g, b;
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return std::min({r.size(), g.size(), b.size()}); }
+};
+
+using MutablePlanes = Planes<std::uint8_t>;
+using ConstPlanes = Planes<const std::uint8_t>;
+
+namespace detail {
+// <cmath> isn't constexpr in C++20, so constant evaluation gets its own exp/log and runtime gets libm.
+[[nodiscard]] constexpr double exp(double x) noexcept {
+  if(!std::is_constant_evaluated())
+    return std::exp(x);
+
+  constexpr double ln2 = 0.693147180559945309417;
+  const auto k = static_cast<int>(x / ln2 + (x < 0 ? -0.5 : 0.5));
+  const double r = x - k * ln2;
+
+  double sum = 1, term = 1;
+  for(int i = 1; i < 24; ++i) {
+    term *= r / i;
+    sum += term;
+  }
+
+  for(int i = 0; i < k; ++i) sum *= 2;
+  for(int i = 0; i > k; --i) sum /= 2;
+  return sum;
+}
+
+[[nodiscard]] constexpr double log(double x) noexcept {
+  if(!std::is_constant_evaluated())
+    return std::log(x);
+
+  constexpr double ln2 = 0.693147180559945309417;
+  int k = 0;
+  for(; x >= 2; x /= 2) ++k;
+  for(; x < 1; x *= 2) --k;
+
+  // log(x) = 2 atanh((x - 1) / (x + 1)), converges fast for x in [1, 2)
+  const double z = (x - 1) / (x + 1), z2 = z * z;
+  double sum = 0, power = z;
+  for(int i = 1; i < 40; i += 2) {
+    sum += power / i;
+    power *= z2;
+  }
+  return 2 * sum + k * ln2;
+}
+
+[[nodiscard]] constexpr double pow(double x, double y) noexcept {
+  if(!std::is_constant_evaluated())
+    return std::pow(x, y);
+  return x <= 0 ? 0 : exp(y * log(x));
+}
+
+[[nodiscard]] constexpr double cbrt(double x) noexcept {
+  if(!std::is_constant_evaluated())
+    return std::cbrt(x);
+  if(x == 0) return 0;
+  return x < 0 ? -exp(log(-x) / 3) : exp(log(x) / 3);
+}
+
+template<Arithmetic T>
+[[nodiscard]] constexpr double unit(T channel) noexcept {
+  if constexpr(std::is_floating_point_v<T>)
+    return channel;
+  else
+    return channel / 255.0;
+}
+
+[[nodiscard]] constexpr std::uint8_t to_channel(double unit) noexcept {
+  unit = unit > 0 ? (unit < 1 ? unit : 1) : 0; // NaN ends up as 0 too
+  return static_cast<std::uint8_t>(unit * 255 + 0.5);
+}
+
+[[nodiscard]] constexpr double to_linear(double c) noexcept {
+  return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+[[nodiscard]] constexpr double to_gamma(double c) noexcept {
+  return c <= 0.0031308 ? c * 12.92 : 1.055 * pow(c, 1 / 2.4) - 0.055;
+}
+
+[[nodiscard]] constexpr double floor(double x) noexcept {
+  if(!std::is_constant_evaluated())
+    return std::floor(x);
+  if(!(x > -0x1p52 && x < 0x1p52))
+    return x; // already integral (or not a number)
+  const auto truncated = static_cast<double>(static_cast<std::int64_t>(x));
+  return truncated > x ? truncated - 1 : truncated;
+}
+
+// any hue into [0, 360) in constant time. NaN and infinities have no direction, they give 0.
+[[nodiscard]] constexpr double wrap_hue(double h) noexcept {
+  if(!(h > std::numeric_limits<double>::lowest() && h < std::numeric_limits<double>::max()))
+    return 0;
+  h -= 360 * floor(h / 360);
+  return h >= 0 && h < 360 ? h : 0; // rounding can land exactly on 360
+}
+
+// hue/chroma back to rgb, shared by hsl and hsv.
+[[nodiscard]] constexpr RGBA from_hue(double h, double chroma, double m) noexcept {
+  h = wrap_hue(h) / 60;
+  const double hmod2 = h - 2 * static_cast<int>(h / 2);
+  const double x = chroma * (1 - (hmod2 > 1 ? hmod2 - 1 : 1 - hmod2));
+
+  double r = 0, g = 0, b = 0;
+  switch(static_cast<int>(h)) {
+    case 0: r = chroma; g = x; break;
+    case 1: r = x; g = chroma; break;
+    case 2: g = chroma; b = x; break;
+    case 3: g = x; b = chroma; break;
+    case 4: r = x; b = chroma; break;
+    default: r = chroma; b = x; break;
+  }
+  return {to_channel(r + m), to_channel(g + m), to_channel(b + m)};
+}
+
+template<Arithmetic T>
+[[nodiscard]] constexpr double hue(const _RGBA<T>& color, double max, double delta) noexcept {
+  if(delta == 0)
+    return 0;
+
+  const double r = unit(color.r), g = unit(color.g), b = unit(color.b);
+  if(max == r) return wrap_hue(60 * ((g - b) / delta));
+  if(max == g) return 60 * ((b - r) / delta + 2);
+  return 60 * ((r - g) / delta + 4);
+}
+
+// 8 bit fixed point lerp, weight in [0, 256]. the SIMD kernels below compute exactly this.
+[[nodiscard]] constexpr std::uint8_t mix(std::uint8_t from, std::uint8_t to, std::uint16_t weight) noexcept {
+  return static_cast<std::uint8_t>((from * (256 - weight) + to * weight + 128) >> 8);
+}
+
+[[nodiscard]] constexpr std::uint16_t weight(float t) noexcept {
+  t = t < 0 ? 0 : t > 1 ? 1 : t;
+  return static_cast<std::uint16_t>(t * 256 + 0.5f);
+}
+
+// colors are processed in blocks of this many cells, so every scratch buffer lives on the stack.
+inline constexpr std::size_t block_size = 256;
+
+COLORIZED_INLINE void quantize_weights(const float* t, std::uint16_t* out, std::size_t n) noexcept;
+
+#if defined(__SSE2__) || defined(_M_X64)
+// eight lanes of mix(), from and to already widened to 16 bit.
+[[nodiscard]] inline __m128i mix8(__m128i from, __m128i to, __m128i weight) noexcept {
+  const __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(256), weight);
+  const __m128i sum = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(from, inverse), _mm_mullo_epi16(to, weight)),
+                                    _mm_set1_epi16(128));
+  return _mm_srli_epi16(sum, 8);
+}
+
+[[nodiscard]] inline __m128i load8(const std::uint8_t* p) noexcept {
+  return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128());
+}
+
+inline void store8(std::uint8_t* p, __m128i v) noexcept {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(v, v));
+}
+#endif
+
+// one plane, per-cell endpoints.
+COLORIZED_INLINE void blend_plane(std::uint8_t* out, const std::uint8_t* from, const std::uint8_t* to,
+                                  const std::uint16_t* weights, std::size_t n) noexcept;
+
+// one plane, same endpoints for every cell.
+COLORIZED_INLINE void blend_plane(std::uint8_t* out, std::uint8_t from, std::uint8_t to,
+                                  const std::uint16_t* weights, std::size_t n) noexcept;
+} // namespace detail
+
+template<Arithmetic T>
+[[nodiscard]] constexpr Hsl to_hsl(const _RGBA<T>& color) noexcept {
+  const double r = detail::unit(color.r), g = detail::unit(color.g), b = detail::unit(color.b);
+  const double max = std::max({r, g, b}), min = std::min({r, g, b}), delta = max - min;
+  const double l = (max + min) / 2;
+  const double s = delta == 0 ? 0 : delta / (1 - (2 * l - 1 < 0 ? 1 - 2 * l : 2 * l - 1));
+
+  return {static_cast<float>(detail::hue(color, max, delta)), static_cast<float>(s), static_cast<float>(l)};
+}
+
+[[nodiscard]] constexpr RGBA from_hsl(const Hsl& hsl) noexcept {
+  const double l = hsl.l, chroma = (1 - (2 * l - 1 < 0 ? 1 - 2 * l : 2 * l - 1)) * hsl.s;
+  return detail::from_hue(hsl.h, chroma, l - chroma / 2);
+}
+
+template<Arithmetic T>
+[[nodiscard]] constexpr Hsv to_hsv(const _RGBA<T>& color) noexcept {
+  const double r = detail::unit(color.r), g = detail::unit(color.g), b = detail::unit(color.b);
+  const double max = std::max({r, g, b}), min = std::min({r, g, b}), delta = max - min;
+
+  return {static_cast<float>(detail::hue(color, max, delta)), static_cast<float>(max == 0 ? 0 : delta / max),
+          static_cast<float>(max)};
+}
+
+[[nodiscard]] constexpr RGBA from_hsv(const Hsv& hsv) noexcept {
+  const double chroma = static_cast<double>(hsv.v) * hsv.s;
+  return detail::from_hue(hsv.h, chroma, hsv.v - chroma);
+}
+
+template<Arithmetic T>
+[[nodiscard]] constexpr OkLab to_oklab(const _RGBA<T>& color) noexcept {
+  const double r = detail::to_linear(detail::unit(color.r));
+  const double g = detail::to_linear(detail::unit(color.g));
+  const double b = detail::to_linear(detail::unit(color.b));
+
+  const double l = detail::cbrt(0.4122214708 * r + 0.5363325363 * g + 0.0514459929 * b);
+  const double m = detail::cbrt(0.2119034982 * r + 0.6806995451 * g + 0.1073969566 * b);
+  const double s = detail::cbrt(0.0883024619 * r + 0.2817188376 * g + 0.6299787005 * b);
+
+  return {
+    static_cast<float>(0.2104542553 * l + 0.7936177850 * m - 0.0040720468 * s),
+    static_cast<float>(1.9779984951 * l - 2.4285922050 * m + 0.4505937099 * s),
+    static_cast<float>(0.0259040371 * l + 0.7827717662 * m - 0.8086757660 * s)
+  };
+}
+
+[[nodiscard]] constexpr RGBA from_oklab(const OkLab& lab) noexcept {
+  const double l_ = lab.L + 0.3963377774 * lab.a + 0.2158037573 * lab.b;
+  const double m_ = lab.L - 0.1055613458 * lab.a - 0.0638541728 * lab.b;
+  const double s_ = lab.L - 0.0894841775 * lab.a - 1.2914855480 * lab.b;
+  const double l = l_ * l_ * l_, m = m_ * m_ * m_, s = s_ * s_ * s_;
+
+  return {
+    detail::to_channel(detail::to_gamma(+4.0767416621 * l - 3.3077115913 * m + 0.2309699292 * s)),
+    detail::to_channel(detail::to_gamma(-1.2684380046 * l + 2.6097574011 * m - 0.3413193965 * s)),
+    detail::to_channel(detail::to_gamma(-0.0041960863 * l - 0.7034186147 * m + 1.7076147010 * s))
+  };
+}
+
+// WCAG relative luminance, 0 for black and 1 for white.
+template<Arithmetic T>
+[[nodiscard]] constexpr float luminance(const _RGBA<T>& color) noexcept {
+  return static_cast<float>(0.2126 * detail::to_linear(detail::unit(color.r)) +
+                            0.7152 * detail::to_linear(detail::unit(color.g)) +
+                            0.0722 * detail::to_linear(detail::unit(color.b)));
+}
+
+// WCAG contrast ratio in [1, 21], order of the arguments doesn't matter.
+template<Arithmetic T>
+[[nodiscard]] constexpr float contrast_ratio(const _RGBA<T>& a, const _RGBA<T>& b) noexcept {
+  const float la = luminance(a), lb = luminance(b);
+  return la > lb ? (la + 0.05f) / (lb + 0.05f) : (lb + 0.05f) / (la + 0.05f);
+}
+
+// t = 0 gives `from`, t = 1 gives `to`; matches the batch functions bit for bit.
+[[nodiscard]] constexpr RGBA blend(const RGBA& from, const RGBA& to, float t) noexcept {
+  const auto w = detail::weight(t);
+  return {detail::mix(from.r, to.r, w), detail::mix(from.g, to.g, w), detail::mix(from.b, to.b, w)};
+}
+
+// perceptual blend, interpolates in OKLab instead of gamma encoded sRGB.
+[[nodiscard]] constexpr RGBA blend_oklab(const RGBA& from, const RGBA& to, float t) noexcept {
+  const auto a = to_oklab(from), b = to_oklab(to);
+  return from_oklab({a.L + (b.L - a.L) * t, a.a + (b.a - a.a) * t, a.b + (b.b - a.b) * t});
+}
+
+// what a terminal (or any other target) can show, from nothing at all up to truecolor.
+enum class ColorDepth : std::uint8_t {
+  Plain,   // no escapes
+  Basic,   // 16 colors, 4-bit codes
+  Indexed, // 256 color palette
+  Direct   // 24-bit truecolor
+};
+
+namespace detail {
+// cheap perceptual weighting, good enough to pick the nearest palette entry.
+[[nodiscard]] constexpr int distance(const Color& a, const Color& b) noexcept {
+  const int dr = a.r - b.r, dg = a.g - b.g, db = a.b - b.b;
+  return 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+}
+
+[[nodiscard]] constexpr int cube_step(std::uint8_t v) noexcept {
+  return v < 48 ? 0 : v < 115 ? 1 : (v - 35) / 40;
+}
+} // namespace detail
+
+// nearest entry of the 6x6x6 cube or the gray ramp; the 16 system colors are left out
+// since every terminal theme redefines them.
+[[nodiscard]] constexpr _8BitColor to_indexed(const RGBA& color) noexcept {
+  const Color target { color };
+  const int cube = 16 + 36 * detail::cube_step(color.r) + 6 * detail::cube_step(color.g) + detail::cube_step(color.b);
+
+  const int average = (color.r + color.g + color.b) / 3;
+  const int gray = 232 + (average < 8 ? 0 : average > 238 ? 23 : (average - 3) / 10);
+
+  const auto cube_distance = detail::distance(target, colorized::detail::palette(static_cast<std::uint8_t>(cube)));
+  const auto gray_distance = detail::distance(target, colorized::detail::palette(static_cast<std::uint8_t>(gray)));
+  return static_cast<_8BitColor>(gray_distance < cube_distance ? gray : cube);
+}
+
+// nearest of the 16 system colors as a foreground code, add 10 for the background one.
+[[nodiscard]] constexpr Foreground to_basic(const RGBA& color) noexcept {
+  const Color target { color };
+  int best = 0, best_distance = detail::distance(target, colorized::detail::palette(0));
+
+  for(int i = 1; i < 16; ++i) {
+    if(const auto d = detail::distance(target, colorized::detail::palette(static_cast<std::uint8_t>(i))); d < best_distance) {
+      best = i;
+      best_distance = d;
+    }
+  }
+  return static_cast<Foreground>(best < 8 ? FgBlack + best : FgBrBlack + best - 8);
+}
+
+// the closest color `depth` can show; colors already within reach are kept as they are.
+[[nodiscard]] constexpr Color downsample(const Color& color, ColorDepth depth, bool background) noexcept {
+  if(depth == ColorDepth::Plain)
+    return {};
+
+  if(depth == ColorDepth::Direct || color.kind == ColorKind::Unset || color.kind == ColorKind::Basic)
+    return color;
+
+  if(depth == ColorDepth::Indexed)
+    return color.kind == ColorKind::Indexed ? color : Color{to_indexed({color.r, color.g, color.b})};
+
+  const auto direct = color.direct();
+  const auto code = to_basic({direct.r, direct.g, direct.b});
+  return background ? Color{static_cast<Background>(code + 10)} : Color{code};
+}
+
+[[nodiscard]] constexpr Attributes downsample(const Attributes& attributes, ColorDepth depth) noexcept {
+  if(depth == ColorDepth::Plain)
+    return {};
+
+  return {attributes.styles, downsample(attributes.foreground, depth, false),
+          downsample(attributes.background, depth, true)};
+}
+
+// picks whichever of the two candidates reads better on `background`.
+[[nodiscard]] constexpr RGBA readable_on(const RGBA& background, const RGBA& dark = {0, 0, 0},
+                                         const RGBA& light = {255, 255, 255}) noexcept {
+  return contrast_ratio(background, dark) >= contrast_ratio(background, light) ? dark : light;
+}
+
+// out[i] = blend(from[i], to[i], t[i]) for every cell all four have; the rest of `out` is left alone.
+COLORIZED_INLINE void blend(ConstPlanes from, ConstPlanes to, std::span<const float> t, MutablePlanes out) noexcept;
+
+// spreads `stops` evenly over all cells of `out`, first cell gets the first stop and last cell the last one.
+COLORIZED_INLINE void gradient(std::span<const RGBA> stops, MutablePlanes out) noexcept;
+
+// heat map: every value in [low, high] is placed on the gradient through `stops`, values outside are clamped.
+// one cell per value, as far as both `values` and `out` go.
+COLORIZED_INLINE void heat(std::span<const float> values, float low, float high, std::span<const RGBA> stops,
+                           MutablePlanes out) noexcept;
+} // namespace colorized::color
+
+#if COLORIZED_DEFINITIONS
+namespace colorized::color {
+namespace detail {
+COLORIZED_INLINE void quantize_weights(const float* t, std::uint16_t* out, std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1), scale = _mm_set1_ps(256), half = _mm_set1_ps(0.5f);
+  const auto quantize = [&](const float* p) {
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), zero), one);
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half)); // same rounding as weight()
+  };
+
+  for(; i + 8 <= n; i += 8)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(quantize(t + i), quantize(t + i + 4)));
+#endif
+  for(; i < n; ++i)
+    out[i] = weight(t[i]);
+}
+
+COLORIZED_INLINE void blend_plane(std::uint8_t* out, const std::uint8_t* from, const std::uint8_t* to,
+                                  const std::uint16_t* weights, std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  for(; i + 8 <= n; i += 8)
+    store8(out + i, mix8(load8(from + i), load8(to + i),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i))));
+#endif
+  for(; i < n; ++i)
+    out[i] = mix(from[i], to[i], weights[i]);
+}
+
+COLORIZED_INLINE void blend_plane(std::uint8_t* out, std::uint8_t from, std::uint8_t to,
+                                  const std::uint16_t* weights, std::size_t n) noexcept {
+  std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128i f = _mm_set1_epi16(from), t = _mm_set1_epi16(to);
+  for(; i + 8 <= n; i += 8)
+    store8(out + i, mix8(f, t, _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i))));
+#endif
+  for(; i < n; ++i)
+    out[i] = mix(from, to, weights[i]);
+}
+} // namespace detail
+
+COLORIZED_INLINE void blend(ConstPlanes from, ConstPlanes to, std::span<const float> t, MutablePlanes out) noexcept {
+  const auto cells = std::min({out.size(), from.size(), to.size(), t.size()});
+  std::uint16_t weights[detail::block_size];
+
+  for(std::size_t first = 0; first < cells; first += detail::block_size) {
+    const auto n = std::min(detail::block_size, cells - first);
+    detail::quantize_weights(t.data() + first, weights, n);
+
+    detail::blend_plane(out.r.data() + first, from.r.data() + first, to.r.data() + first, weights, n);
+    detail::blend_plane(out.g.data() + first, from.g.data() + first, to.g.data() + first, weights, n);
+    detail::blend_plane(out.b.data() + first, from.b.data() + first, to.b.data() + first, weights, n);
+  }
+}
+
+COLORIZED_INLINE void gradient(std::span<const RGBA> stops, MutablePlanes out) noexcept {
+  const auto n = out.size();
+  if(n == 0 || stops.empty())
+    return;
+
+  if(stops.size() == 1 || n == 1) {
+    std::fill_n(out.r.begin(), n, stops.front().r);
+    std::fill_n(out.g.begin(), n, stops.front().g);
+    std::fill_n(out.b.begin(), n, stops.front().b);
+    return;
+  }
+
+  std::uint16_t weights[detail::block_size];
+  const double scale = static_cast<double>(stops.size() - 1) / static_cast<double>(n - 1);
+
+  for(std::size_t first = 0; first < n;) {
+    // every run of cells between the same two stops goes through the uniform kernel.
+    const auto segment = std::min(static_cast<std::size_t>(first * scale), stops.size() - 2);
+    auto last = static_cast<std::size_t>(std::ceil((segment + 1) / scale));
+    last = std::clamp(last, first + 1, std::min(n, first + detail::block_size));
+
+    for(std::size_t i = first; i < last; ++i)
+      weights[i - first] = detail::weight(static_cast<float>(i * scale - static_cast<double>(segment)));
+
+    const auto& from = stops[segment];
+    const auto& to = stops[segment + 1];
+    detail::blend_plane(out.r.data() + first, from.r, to.r, weights, last - first);
+    detail::blend_plane(out.g.data() + first, from.g, to.g, weights, last - first);
+    detail::blend_plane(out.b.data() + first, from.b, to.b, weights, last - first);
+    first = last;
+  }
+}
+
+COLORIZED_INLINE void heat(std::span<const float> values, float low, float high, std::span<const RGBA> stops,
+                           MutablePlanes out) noexcept {
+  if(stops.empty())
+    return;
+
+  std::uint8_t from[3][detail::block_size], to[3][detail::block_size];
+  float t[detail::block_size];
+  std::uint16_t weights[detail::block_size];
+
+  const auto segments = static_cast<float>(stops.size() - 1);
+  const float range = high > low ? high - low : 1.0f;
+  const auto cells = std::min(out.size(), values.size());
+
+  for(std::size_t first = 0; first < cells; first += detail::block_size) {
+    const auto n = std::min(detail::block_size, cells - first);
+
+    // gather the two stops around every value, then blend all cells in one go.
+    for(std::size_t i = 0; i < n; ++i) {
+      const float position = std::clamp((values[first + i] - low) / range, 0.0f, 1.0f) * segments;
+      const auto segment = std::min(static_cast<std::size_t>(position), stops.size() > 1 ? stops.size() - 2 : 0);
+      const auto& a = stops[segment];
+      const auto& b = stops[std::min(segment + 1, stops.size() - 1)];
+
+      from[0][i] = a.r; from[1][i] = a.g; from[2][i] = a.b;
+      to[0][i] = b.r; to[1][i] = b.g; to[2][i] = b.b;
+      t[i] = position - static_cast<float>(segment);
+    }
+
+    detail::quantize_weights(t, weights, n);
+    detail::blend_plane(out.r.data() + first, from[0], to[0], weights, n);
+    detail::blend_plane(out.g.data() + first, from[1], to[1], weights, n);
+    detail::blend_plane(out.b.data() + first, from[2], to[2], weights, n);
+  }
+}
+} // namespace colorized::color
+#endif // COLORIZED_DEFINITIONS
@@ -0,0 +1,25 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+// colorized is header only by default. defining COLORIZED_COMPILED_LIB (the `colorized` cmake
+// target does it for you) turns the non-template parts -- runtime sequence generation, the
+// color batch kernels, width measurement, layout, sinks -- into plain declarations, and
+// colorized.cc builds their definitions once. templates stay in the headers either way.
+#if defined(COLORIZED_COMPILED_LIB)
+#define COLORIZED_INLINE
+#else
+#define COLORIZED_INLINE inline
+#endif
+
+// definitions at the end of each header are seen by everyone in header only mode and
+// only by colorized.cc (which defines COLORIZED_COMPILING_LIB) otherwise.
+#if !defined(COLORIZED_COMPILED_LIB) || defined(COLORIZED_COMPILING_LIB)
+#define COLORIZED_DEFINITIONS 1
+#else
+#define COLORIZED_DEFINITIONS 0
+#endif
@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized_color.hh"
+#include "colorized_unicode.hh"
+
+namespace colorized {
+// what a single gradient step covers.
+enum class GradientUnit : std::uint8_t {
+  Character, // code point
+  Grapheme,  // user perceived character, keeps emoji and combining marks in one piece
+  Word       // run of non whitespace, spaces between words never change the color
+};
+
+struct GradientOptions {
+  GradientUnit unit { GradientUnit::Grapheme };
+  color::ColorDepth depth { color::ColorDepth::Direct };
+  bool background { false }; // paint the background instead of the foreground
+};
+
+namespace detail {
+[[nodiscard]] constexpr bool is_blank(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// end of the unit starting at `pos`; words swallow the blanks that follow them.
+[[nodiscard]] constexpr std::size_t next_unit(std::string_view text, std::size_t pos, GradientUnit unit) noexcept {
+  switch(unit) {
+    case GradientUnit::Character: {
+      static_cast<void>(unicode::next(text, pos));
+      return pos;
+    }
+    case GradientUnit::Grapheme: return unicode::next_grapheme(text, pos);
+    case GradientUnit::Word: {
+      while(pos < text.size() && !is_blank(text[pos])) ++pos;
+      while(pos < text.size() && is_blank(text[pos])) ++pos;
+      return pos;
+    }
+  }
+  return text.size();
+}
+
+// color of unit `i` out of `n`, the same spacing color::gradient uses.
+[[nodiscard]] constexpr RGBA gradient_at(std::span<const RGBA> stops, std::size_t i, std::size_t n) noexcept {
+  if(stops.size() == 1 || n <= 1)
+    return stops.front();
+
+  const double position = static_cast<double>(i) * static_cast<double>(stops.size() - 1) / static_cast<double>(n - 1);
+  const auto segment = std::min(static_cast<std::size_t>(position), stops.size() - 2);
+  return color::blend(stops[segment], stops[segment + 1], static_cast<float>(position - static_cast<double>(segment)));
+}
+
+// walks the text once to count units and once to emit it. neighbouring units that land on
+// the same color after downsampling share one escape, blank units never force a change
+// when only the foreground is painted.
+template<typename Sink>
+void gradient_runs(Style style, std::span<const RGBA> stops, std::string_view text,
+                          const GradientOptions& options, Sink&& sink) noexcept {
+  if(stops.empty() || options.depth == color::ColorDepth::Plain) {
+    sink(text);
+    return;
+  }
+
+  std::size_t units = 0;
+  for(std::size_t pos = 0; pos < text.size(); pos = next_unit(text, pos, options.unit))
+    ++units;
+
+  Color current {};
+  std::size_t run = 0, index = 0;
+
+  for(std::size_t pos = 0; pos < text.size(); ++index) {
+    const auto end = next_unit(text, pos, options.unit);
+    const bool invisible = !options.background && is_blank(text[pos]) && current.is_set();
+
+    if(!invisible) {
+      const auto color = color::downsample(Color{gradient_at(stops, index, units)}, options.depth, options.background);
+
+      if(color != current) {
+        if(pos != run)
+          sink(text.substr(run, pos - run));
+
+        SequenceBuffer buffer;
+        if(!current.is_set()) {
+          Attributes attributes { static_cast<std::uint8_t>(1u << style) };
+          (options.background ? attributes.background : attributes.foreground) = color;
+          buffer = sequence(attributes);
+        } else {
+          buffer.color(color, options.background);
+          buffer.finish();
+        }
+
+        sink(buffer.view());
+        current = color;
+        run = pos;
+      }
+    }
+    pos = end;
+  }
+
+  if(run != text.size())
+    sink(text.substr(run));
+  if(current.is_set())
+    sink(constants::reset_color);
+}
+} // namespace detail
+
+// colors `text` along the gradient through `stops`, ends with a reset.
+template<std::output_iterator<char> Out>
+Out render_gradient(Out out, Style style, std::span<const RGBA> stops, std::string_view text,
+                           GradientOptions options = {}) noexcept {
+  detail::gradient_runs(style, stops, text, options, [&out](std::string_view piece) {
+    out = detail::copy_to(out, piece);
+  });
+  return out;
+}
+
+template<typename Stream>
+void print_gradient(Style style, std::span<const RGBA> stops, Stream& stream, std::string_view text,
+                           GradientOptions options = {}) noexcept {
+  detail::gradient_runs(style, stops, text, options, [&stream](std::string_view piece) {
+    stream << piece;
+  });
+}
+
+COLORIZED_INLINE void print_gradient_cout(Style style, std::span<const RGBA> stops, std::string_view text,
+                                          GradientOptions options = {}) noexcept;
+
+COLORIZED_INLINE void print_gradient_cerr(Style style, std::span<const RGBA> stops, std::string_view text,
+                                          GradientOptions options = {}) noexcept;
+} // namespace colorized
+
+#if COLORIZED_DEFINITIONS
+namespace colorized {
+COLORIZED_INLINE void print_gradient_cout(Style style, std::span<const RGBA> stops, std::string_view text,
+                                          GradientOptions options) noexcept {
+  print_gradient(style, stops, std::cout, text, options);
+}
+
+COLORIZED_INLINE void print_gradient_cerr(Style style, std::span<const RGBA> stops, std::string_view text,
+                                          GradientOptions options) noexcept {
+  print_gradient(style, stops, std::cerr, text, options);
+}
+} // namespace colorized
+#endif // COLORIZED_DEFINITIONS
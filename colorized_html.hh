@@ -0,0 +1,250 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized.hh"
+#include <algorithm>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace colorized::html {
+struct Options {
+  std::string_view class_prefix { "c" };
+  // once that many distinct styles are seen, the rest are written as inline style attributes.
+  std::size_t max_classes { 4096 };
+  // output is handed to the stream in chunks of this size.
+  std::size_t flush_threshold { 1 << 16 };
+  bool wrap_pre { true };
+};
+
+namespace detail {
+[[nodiscard]] constexpr bool is_markup(char c) noexcept {
+  return c == '<' || c == '>' || c == '&';
+}
+
+// first byte that needs an html entity, 16 bytes per step where SSE2 is around.
+[[nodiscard]] COLORIZED_INLINE const char* find_markup(const char* first, const char* last) noexcept;
+
+COLORIZED_INLINE void append_hex(std::string& out, const Color& color) noexcept;
+
+// css declarations for one attribute set, without the surrounding braces or quotes.
+COLORIZED_INLINE void append_css(std::string& out, const Attributes& attributes) noexcept;
+} // namespace detail
+
+// streaming ansi to html converter. feed it chunks of any size, memory stays bounded by
+// the flush threshold and the class limit no matter how large the input gets.
+// every distinct attribute set gets one css class, declared in a <style> right before its first use.
+template<typename Stream>
+class Converter {
+public:
+  explicit Converter(Stream& stream, Options options = {}) noexcept
+    : stream{stream}, options{options} {
+    buffer.reserve(options.flush_threshold + 256);
+    if(options.wrap_pre)
+      buffer += "<pre class=\"colorized\">";
+  }
+
+  Converter(const Converter&) = delete;
+  Converter& operator=(const Converter&) = delete;
+
+  ~Converter() { finish(); }
+
+  void feed(std::string_view chunk) noexcept {
+    decoder.feed(chunk,
+      [this](std::string_view text) { write_text(text); },
+      [this](const Attributes& attributes) { pending = attributes; });
+
+    flush_if_full();
+  }
+
+  // closes the open span (and <pre>) and hands everything left to the stream.
+  void finish() noexcept {
+    if(finished)
+      return;
+
+    close_span();
+    flush_if_full();
+    if(options.wrap_pre)
+      buffer += "</pre>\n";
+
+    flush();
+    finished = true;
+  }
+
+private:
+  void flush() noexcept {
+    stream << std::string_view{buffer};
+    buffer.clear();
+  }
+
+  void flush_if_full() noexcept {
+    if(buffer.size() >= options.flush_threshold)
+      flush();
+  }
+
+  void close_span() noexcept {
+    if(open) {
+      buffer += "</span>";
+      open = false;
+    }
+  }
+
+  // spans are opened lazily, so back to back sequences with no text between them cost nothing.
+  void open_span() noexcept {
+    close_span();
+    current = pending;
+
+    if(current.empty())
+      return;
+
+    if(const auto it = classes.find(current); it != classes.end()) {
+      append_class(it->second);
+    } else if(classes.size() < options.max_classes) {
+      const auto id = classes.size();
+      classes.emplace(current, id);
+
+      buffer += "<style>.";
+      buffer += options.class_prefix;
+      buffer += std::to_string(id);
+      buffer += '{';
+      detail::append_css(buffer, current);
+      buffer += "}</style>";
+      append_class(id);
+    } else {
+      buffer += "<span style=\"";
+      detail::append_css(buffer, current);
+      buffer += "\">";
+    }
+
+    open = true;
+    flush_if_full();
+  }
+
+  void append_class(std::size_t id) noexcept {
+    buffer += "<span class=\"";
+    buffer += options.class_prefix;
+    buffer += std::to_string(id);
+    buffer += "\">";
+  }
+
+  void write_text(std::string_view text) noexcept {
+    if(pending != current || (!open && !pending.empty()))
+      open_span();
+
+    const char* it = text.data();
+    const char* const end = it + text.size();
+
+    while(it != end) {
+      const char* markup = detail::find_markup(it, end);
+      append_plain(it, markup);
+
+      if(markup == end)
+        break;
+
+      switch(*markup) {
+        case '<': buffer += "&lt;"; break;
+        case '>': buffer += "&gt;"; break;
+        default: buffer += "&amp;"; break;
+      }
+
+      it = markup + 1;
+      flush_if_full();
+    }
+  }
+
+  // markup free text goes in slices that fit under the threshold, so a single huge run
+  // is handed out piece by piece instead of piling up in the buffer.
+  void append_plain(const char* first, const char* last) noexcept {
+    while(first != last) {
+      flush_if_full();
+      const auto room = std::max<std::size_t>(options.flush_threshold - buffer.size(), 1);
+      const auto n = std::min(room, static_cast<std::size_t>(last - first));
+      buffer.append(first, n);
+      first += n;
+    }
+  }
+
+  Stream& stream;
+  Options options;
+  AnsiDecoder decoder;
+  std::string buffer;
+  std::unordered_map<Attributes, std::size_t> classes;
+  Attributes pending {}, current {};
+  bool open { false }, finished { false };
+};
+
+// converts everything readable from `in`, chunk by chunk.
+template<typename In, typename Out>
+void convert(In& in, Out& out, Options options = {}) noexcept {
+  Converter<Out> converter { out, options };
+  std::string chunk(1 << 16, '\0'); // independent of the flush threshold, which may be 0
+
+  while(in.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || in.gcount() > 0)
+    converter.feed(std::string_view{chunk.data(), static_cast<std::size_t>(in.gcount())});
+
+  converter.finish();
+}
+} // namespace colorized::html
+
+#if COLORIZED_DEFINITIONS
+namespace colorized::html {
+namespace detail {
+[[nodiscard]] COLORIZED_INLINE const char* find_markup(const char* first, const char* last) noexcept {
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128i lt = _mm_set1_epi8('<'), gt = _mm_set1_epi8('>'), amp = _mm_set1_epi8('&');
+
+  for(; last - first >= 16; first += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, lt), _mm_cmpeq_epi8(block, gt)),
+                                      _mm_cmpeq_epi8(block, amp));
+
+    if(const int mask = _mm_movemask_epi8(hits); mask != 0)
+      return first + __builtin_ctz(static_cast<unsigned>(mask));
+  }
+#endif
+  while(first != last && !is_markup(*first))
+    ++first;
+  return first;
+}
+
+COLORIZED_INLINE void append_hex(std::string& out, const Color& color) noexcept {
+  constexpr std::string_view digits { "0123456789abcdef" };
+
+  out += '#';
+  for(const std::uint8_t channel : {color.r, color.g, color.b}) {
+    out += digits[channel >> 4];
+    out += digits[channel & 0xf];
+  }
+}
+
+COLORIZED_INLINE void append_css(std::string& out, const Attributes& attributes) noexcept {
+  if(const auto fg = attributes.foreground.direct(); fg.is_set()) {
+    out += "color:";
+    append_hex(out, fg);
+    out += ';';
+  }
+
+  if(const auto bg = attributes.background.direct(); bg.is_set()) {
+    out += "background-color:";
+    append_hex(out, bg);
+    out += ';';
+  }
+
+  if(attributes.has(Bold)) out += "font-weight:bold;";
+  if(attributes.has(Dim)) out += "opacity:.6;";
+  if(attributes.has(Italic)) out += "font-style:italic;";
+
+  if(attributes.has(Underline) && attributes.has(Blink)) out += "text-decoration:underline blink;";
+  else if(attributes.has(Underline)) out += "text-decoration:underline;";
+  else if(attributes.has(Blink)) out += "text-decoration:blink;";
+}
+} // namespace detail
+} // namespace colorized::html
+#endif // COLORIZED_DEFINITIONS
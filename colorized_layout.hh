@@ -0,0 +1,259 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized_styled_string.hh"
+#include "colorized_unicode.hh"
+#include <vector>
+
+// layout for styled text: measuring, truncating, wrapping, padding and tables. everything
+// works on StyledString, so lines cut out of a longer string keep their runs and every
+// rendered line opens and closes its own styles; nothing bleeds into padding or the next line.
+// raw colored strings can come in through StyledString::parse.
+namespace colorized::layout {
+enum class Align : std::uint8_t { Left, Right, Center };
+
+enum class Overflow : std::uint8_t {
+  Truncate, // cut at the column width and add an ellipsis
+  Wrap      // break into more lines, the row grows instead
+};
+
+namespace detail {
+// advances over one grapheme at `pos`, reports its width. plain ascii skips the cluster logic.
+[[nodiscard]] COLORIZED_INLINE std::size_t step(std::string_view text, std::size_t pos, std::size_t& columns) noexcept;
+
+[[nodiscard]] constexpr bool is_space(char c) noexcept { return c == ' ' || c == '\t'; }
+} // namespace detail
+
+[[nodiscard]] COLORIZED_INLINE std::size_t width(const StyledString& str) noexcept;
+
+// byte offset where the first `columns` columns of `text` end, a wide character that would
+// straddle the limit stays out. `used` gets the columns actually taken.
+[[nodiscard]] COLORIZED_INLINE std::size_t fit(std::string_view text, std::size_t columns, std::size_t& used) noexcept;
+
+// at most `columns` wide, ending in `ellipsis` (styled like the cut off text) when it had to cut.
+[[nodiscard]] COLORIZED_INLINE StyledString truncate(const StyledString& str, std::size_t columns,
+                                                     std::string_view ellipsis = "…", std::size_t known_width = std::string_view::npos) noexcept;
+
+// greedy word wrap to `columns`. breaks after blanks when it can, inside words when a word
+// alone is too wide, and always at '\n'. blanks at the break are dropped.
+[[nodiscard]] COLORIZED_INLINE std::vector<StyledString> wrap(const StyledString& str, std::size_t columns) noexcept;
+
+// writes `str` padded with plain spaces to exactly `columns` columns (truncating nothing).
+template<typename Stream>
+void write_padded(Stream& stream, const StyledString& str, std::size_t str_width, std::size_t columns, Align align) noexcept {
+  const auto gap = columns > str_width ? columns - str_width : 0;
+  const auto left = align == Align::Right ? gap : align == Align::Center ? gap / 2 : 0;
+
+  for(std::size_t i = 0; i < left; ++i) stream << ' ';
+  stream << str;
+  for(std::size_t i = left; i < gap; ++i) stream << ' ';
+}
+
+struct Column {
+  std::size_t max_width { std::string_view::npos };
+  Align align { Align::Left };
+  Overflow overflow { Overflow::Truncate };
+};
+
+// column aligned table of styled cells. every cell is measured once, when its row is added,
+// and column widths are kept up to date as rows come in, so rendering never measures again
+// (apart from cells that have to be cut or wrapped).
+class Table {
+public:
+  explicit Table(std::vector<Column> columns, std::string separator = " ") noexcept
+    : columns{std::move(columns)}, separator{std::move(separator)}, widths(this->columns.size(), 0) {}
+
+  // missing cells are empty, extra ones are ignored.
+  void add_row(std::vector<StyledString> cells) noexcept {
+    cells.resize(columns.size());
+
+    auto& row = rows.emplace_back();
+    row.reserve(cells.size());
+
+    for(std::size_t i = 0; i < cells.size(); ++i) {
+      const auto w = width(cells[i]);
+      widths[i] = std::max(widths[i], std::min(w, columns[i].max_width));
+      row.push_back({std::move(cells[i]), w});
+    }
+  }
+
+  [[nodiscard]] const std::vector<std::size_t>& column_widths() const noexcept { return widths; }
+  [[nodiscard]] std::size_t size() const noexcept { return rows.size(); }
+
+  template<typename Stream>
+  void render(Stream& stream) const noexcept {
+    std::vector<std::vector<StyledString>> wrapped(columns.size());
+    std::vector<std::vector<std::size_t>> wrapped_widths(columns.size());
+
+    for(const auto& row : rows) {
+      std::size_t height = 1;
+
+      for(std::size_t i = 0; i < columns.size(); ++i) {
+        auto& lines = wrapped[i];
+        auto& line_widths = wrapped_widths[i];
+        lines.clear();
+        line_widths.clear();
+
+        const auto& cell = row[i];
+        if(cell.width <= widths[i]) {
+          continue; // fits, rendered straight from the row below
+        } else if(columns[i].overflow == Overflow::Wrap) {
+          lines = wrap(cell.text, widths[i]);
+        } else {
+          lines.push_back(truncate(cell.text, widths[i], "…", cell.width));
+        }
+
+        for(const auto& line : lines)
+          line_widths.push_back(width(line));
+        height = std::max(height, lines.size());
+      }
+
+      for(std::size_t line = 0; line < height; ++line) {
+        for(std::size_t i = 0; i < columns.size(); ++i) {
+          if(i != 0)
+            stream << std::string_view{separator};
+
+          const auto& cell = row[i];
+          if(wrapped[i].empty()) {
+            if(line == 0) write_padded(stream, cell.text, cell.width, widths[i], columns[i].align);
+            else write_padded(stream, StyledString{}, 0, widths[i], columns[i].align);
+          } else if(line < wrapped[i].size()) {
+            write_padded(stream, wrapped[i][line], wrapped_widths[i][line], widths[i], columns[i].align);
+          } else {
+            write_padded(stream, StyledString{}, 0, widths[i], columns[i].align);
+          }
+        }
+        stream << '\n';
+      }
+    }
+  }
+
+private:
+  struct Cell {
+    StyledString text;
+    std::size_t width;
+  };
+
+  std::vector<Column> columns;
+  std::string separator;
+  std::vector<std::size_t> widths;
+  std::vector<std::vector<Cell>> rows;
+};
+} // namespace colorized::layout
+
+#if COLORIZED_DEFINITIONS
+namespace colorized::layout {
+namespace detail {
+[[nodiscard]] COLORIZED_INLINE std::size_t step(std::string_view text, std::size_t pos, std::size_t& columns) noexcept {
+  const auto c = static_cast<unsigned char>(text[pos]);
+  if(c >= 0x20 && c < 0x7f && (pos + 1 == text.size() || static_cast<unsigned char>(text[pos + 1]) < 0x80)) {
+    columns = 1;
+    return pos + 1;
+  }
+
+  const auto end = unicode::next_grapheme(text, pos);
+  columns = static_cast<std::size_t>(unicode::grapheme_width(text, pos, end));
+  return end;
+}
+} // namespace detail
+
+[[nodiscard]] COLORIZED_INLINE std::size_t width(const StyledString& str) noexcept {
+  return unicode::display_width(str.text());
+}
+
+[[nodiscard]] COLORIZED_INLINE std::size_t fit(std::string_view text, std::size_t columns, std::size_t& used) noexcept {
+  std::size_t pos = 0;
+  used = 0;
+
+  while(pos < text.size()) {
+    std::size_t w;
+    const auto next = detail::step(text, pos, w);
+    if(used + w > columns)
+      break;
+    used += w;
+    pos = next;
+  }
+  return pos;
+}
+
+[[nodiscard]] COLORIZED_INLINE StyledString truncate(const StyledString& str, std::size_t columns,
+                                                     std::string_view ellipsis, std::size_t known_width) noexcept {
+  const auto total = known_width != std::string_view::npos ? known_width : width(str);
+  if(total <= columns)
+    return str;
+
+  const auto ellipsis_width = unicode::display_width(ellipsis);
+  if(ellipsis_width > columns) {
+    std::size_t used;
+    return str.substr(0, fit(str.text(), columns, used));
+  }
+
+  std::size_t used;
+  const auto end = fit(str.text(), columns - ellipsis_width, used);
+  auto result = str.substr(0, end);
+
+  Attributes attributes {};
+  for(std::size_t i = 0; i < str.run_count() && str.run(i).offset <= end; ++i)
+    attributes = str.run(i).attributes;
+
+  result.append(ellipsis, attributes);
+  return result;
+}
+
+[[nodiscard]] COLORIZED_INLINE std::vector<StyledString> wrap(const StyledString& str, std::size_t columns) noexcept {
+  std::vector<StyledString> lines;
+  const auto text = str.text();
+  columns = columns == 0 ? 1 : columns;
+
+  std::size_t start = 0, pos = 0, used = 0;
+  std::size_t last_break = std::string_view::npos; // first byte after the last blank run
+
+  const auto emit = [&](std::size_t end, std::size_t resume) {
+    auto trimmed = end;
+    while(trimmed > start && detail::is_space(text[trimmed - 1]))
+      --trimmed;
+    lines.push_back(str.substr(start, trimmed - start));
+
+    start = pos = resume;
+    used = 0;
+    last_break = std::string_view::npos;
+  };
+
+  while(pos < text.size()) {
+    if(text[pos] == '\n') {
+      emit(pos, pos + 1);
+      continue;
+    }
+
+    std::size_t w;
+    const auto next = detail::step(text, pos, w);
+
+    if(used + w > columns && !detail::is_space(text[pos])) {
+      if(last_break != std::string_view::npos && last_break > start) {
+        const auto resume = last_break;
+        emit(last_break, resume);
+      } else if(pos > start) {
+        emit(pos, pos);
+      } else {
+        emit(next, next); // a single grapheme wider than the line
+      }
+      continue;
+    }
+
+    used += w;
+    pos = next;
+    if(detail::is_space(text[pos - 1]) && (pos == text.size() || !detail::is_space(text[pos])))
+      last_break = pos;
+  }
+
+  if(start < text.size() || lines.empty())
+    emit(text.size(), text.size()); // the last line drops trailing blanks like every other
+  return lines;
+}
+} // namespace colorized::layout
+#endif // COLORIZED_DEFINITIONS
@@ -0,0 +1,249 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized.hh"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace colorized::live {
+struct BarStyle {
+  Attributes label {};
+  Attributes fill { 0, Color{FgGreen} };
+  Attributes empty { 1u << Dim };
+  Attributes counter {};
+  std::size_t width { 30 }; // cells of the bar itself, 0 hides it
+};
+
+// one line of a live region. producers only ever touch the atomics, so updating it from
+// any number of threads costs one relaxed read-modify-write and never blocks.
+// a bar with total 0 renders as a plain status counter.
+class Bar {
+public:
+  Bar(std::string label, std::uint64_t total, BarStyle style) noexcept
+    : label{std::move(label)}, style{style}, total_count{total} {}
+
+  void add(std::uint64_t n = 1) noexcept { current_count.fetch_add(n, std::memory_order_relaxed); }
+  void set(std::uint64_t n) noexcept { current_count.store(n, std::memory_order_relaxed); }
+  void set_total(std::uint64_t n) noexcept { total_count.store(n, std::memory_order_relaxed); }
+
+  [[nodiscard]] std::uint64_t current() const noexcept { return current_count.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::uint64_t total() const noexcept { return total_count.load(std::memory_order_relaxed); }
+
+  const std::string label;
+  const BarStyle style;
+
+private:
+  // own cache line, producers hammering one bar don't slow down readers of the others.
+  alignas(64) std::atomic<std::uint64_t> current_count { 0 };
+  std::atomic<std::uint64_t> total_count;
+};
+
+namespace detail {
+COLORIZED_INLINE void append_number(std::string& out, std::uint64_t n) noexcept;
+
+// runs `write` between the sequence for `attributes` and the reset, skipped entirely when
+// it writes nothing, so empty parts of a line cost no escapes.
+template<typename Write>
+void append_styled(std::string& out, const Attributes& attributes, Write&& write) noexcept {
+  const auto prefix = colorized::detail::sequence(attributes);
+  const auto mark = out.size();
+
+  out += prefix.view();
+  const auto text = out.size();
+  write();
+
+  if(out.size() == text)
+    out.resize(mark);
+  else if(prefix.size != 0)
+    out += constants::reset_color;
+}
+
+// part * factor / total for part <= total, without the product overflowing: byte counters
+// easily pass the ~1.8e17 where `part * 100` stops fitting in 64 bits.
+[[nodiscard]] constexpr std::uint64_t proportion(std::uint64_t part, std::uint64_t factor, std::uint64_t total) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ using wide = unsigned __int128;
+  return static_cast<std::uint64_t>(static_cast<wide>(part) * factor / total);
+#else
+  // no 128 bit type: drop low bits of both until the product fits, the ratio barely moves.
+  while(factor != 0 && part > std::numeric_limits<std::uint64_t>::max() / factor) {
+    part >>= 1;
+    total >>= 1;
+  }
+  return part * factor / total;
+#endif
+}
+
+COLORIZED_INLINE void render_bar(std::string& out, const Bar& bar) noexcept;
+} // namespace detail
+
+// block of bars redrawn in place by one background thread at most once per interval.
+// any number of updates between two frames collapse into a single redraw, and only the
+// lines whose text changed are rewritten. nothing else should write to the stream while it runs.
+template<typename Stream = std::ostream>
+class Region {
+public:
+  explicit Region(Stream& stream, std::chrono::milliseconds interval = std::chrono::milliseconds{100}) noexcept
+    : stream{stream}, interval{interval} {}
+
+  Region(const Region&) = delete;
+  Region& operator=(const Region&) = delete;
+
+  ~Region() { stop(); }
+
+  // references stay valid for the lifetime of the region; bars may be added while it's running.
+  Bar& add_bar(std::string label, std::uint64_t total = 0, BarStyle style = {}) noexcept {
+    std::lock_guard lock { mutex };
+    auto& bar = bars.emplace_back(std::move(label), total, style);
+    lines.emplace_back();
+    changed.push_back(false);
+    return bar;
+  }
+
+  void start() noexcept {
+    if(!renderer.joinable())
+      renderer = std::jthread{[this](std::stop_token token) { run(token); }};
+  }
+
+  // stops the renderer and draws one last frame so the final counts are on screen.
+  void stop() noexcept {
+    if(renderer.joinable()) {
+      renderer.request_stop();
+      renderer.join();
+    }
+    redraw();
+  }
+
+  // draws a frame right away, for callers that don't want the background thread at all.
+  void redraw() noexcept {
+    std::lock_guard lock { mutex };
+    frame.clear();
+
+    std::size_t first_changed = lines.size();
+    for(std::size_t i = 0; i < bars.size(); ++i) {
+      detail::render_bar(scratch, bars[i]);
+      if(i >= drawn || scratch != lines[i]) {
+        lines[i].swap(scratch);
+        changed[i] = true;
+        first_changed = std::min(first_changed, i);
+      } else {
+        changed[i] = false;
+      }
+    }
+
+    if(first_changed == lines.size())
+      return;
+
+    // the cursor rests on the line below the region between frames.
+    if(const auto up = drawn - std::min(first_changed, drawn); up != 0)
+      append_move(up, 'A');
+
+    std::size_t skipped = 0;
+    for(std::size_t i = first_changed; i < lines.size(); ++i) {
+      if(i < drawn && !changed[i]) {
+        ++skipped;
+        continue;
+      }
+
+      if(skipped != 0) {
+        append_move(skipped, 'B');
+        skipped = 0;
+      }
+
+      frame += "\r\x1b[2K";
+      frame += lines[i];
+      frame += '\n';
+    }
+
+    if(skipped != 0)
+      append_move(skipped, 'B');
+
+    drawn = lines.size();
+    stream << std::string_view{frame};
+    if constexpr(requires { stream.flush(); })
+      stream.flush();
+  }
+
+private:
+  void run(std::stop_token token) noexcept {
+    std::mutex sleep_mutex;
+    std::condition_variable_any wakeup;
+
+    while(!token.stop_requested()) {
+      redraw();
+
+      std::unique_lock lock { sleep_mutex };
+      wakeup.wait_for(lock, token, interval, [] { return false; });
+    }
+  }
+
+  void append_move(std::size_t n, char direction) noexcept {
+    frame += "\x1b[";
+    detail::append_number(frame, n);
+    frame += direction;
+  }
+
+  Stream& stream;
+  std::chrono::milliseconds interval;
+  std::mutex mutex;
+  std::deque<Bar> bars;
+  std::deque<std::string> lines;
+  std::string frame, scratch;
+  std::size_t drawn { 0 };
+  std::vector<bool> changed;
+  std::jthread renderer;
+};
+} // namespace colorized::live
+
+#if COLORIZED_DEFINITIONS
+namespace colorized::live {
+namespace detail {
+COLORIZED_INLINE void append_number(std::string& out, std::uint64_t n) noexcept {
+  char buffer[24];
+  const auto [end, ec] = std::to_chars(buffer, buffer + sizeof buffer, n);
+  out.append(buffer, end);
+}
+
+COLORIZED_INLINE void render_bar(std::string& out, const Bar& bar) noexcept {
+  const auto current = bar.current();
+  const auto total = bar.total();
+  const auto clamped = current < total ? current : total;
+
+  out.clear();
+  append_styled(out, bar.style.label, [&] { out += bar.label; });
+  out += ' ';
+
+  if(total != 0 && bar.style.width != 0) {
+    const auto filled = static_cast<std::size_t>(proportion(clamped, bar.style.width, total));
+
+    append_styled(out, bar.style.fill, [&] { for(std::size_t i = 0; i < filled; ++i) out += "█"; });
+    append_styled(out, bar.style.empty, [&] { for(std::size_t i = filled; i < bar.style.width; ++i) out += "░"; });
+    out += ' ';
+  }
+
+  append_styled(out, bar.style.counter, [&] {
+    append_number(out, current);
+    if(total != 0) {
+      out += '/';
+      append_number(out, total);
+      out += ' ';
+      append_number(out, proportion(clamped, 100, total));
+      out += '%';
+    }
+  });
+}
+} // namespace detail
+} // namespace colorized::live
+#endif // COLORIZED_DEFINITIONS
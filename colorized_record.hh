@@ -0,0 +1,324 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized_color.hh"
+#include <unordered_map>
+#include <vector>
+
+// compact capture format for styled output. instead of raw escapes, a recording keeps every
+// distinct attribute set once and refers to it by index afterwards:
+//
+//   "CZR1"                                     magic and version
+//   0x01 styles fg bg                          define the next style id
+//   0x02 varint id                             switch to a defined style
+//   0x03 varint length, bytes                  text in the current style
+//
+// fg and bg are a kind byte (ColorKind) followed by 0, 1 or 3 bytes of payload.
+// varints are unsigned LEB128. a recording starts in style {} (no attributes).
+namespace colorized::record {
+inline constexpr std::string_view magic { "CZR1" };
+
+enum Tag : std::uint8_t {
+  DefineStyle = 1,
+  UseStyle,
+  Text
+};
+
+namespace detail {
+COLORIZED_INLINE void put_varint(std::string& out, std::uint64_t n) noexcept;
+
+COLORIZED_INLINE void put_color(std::string& out, const Color& color) noexcept;
+
+// bounds checked reads over a contiguous recording.
+struct MemorySource {
+  std::string_view data;
+  std::size_t pos { 0 };
+
+  [[nodiscard]] bool done() noexcept { return pos >= data.size(); }
+
+  [[nodiscard]] bool byte(std::uint8_t& out) noexcept {
+    if(pos >= data.size()) return false;
+    out = static_cast<std::uint8_t>(data[pos++]);
+    return true;
+  }
+
+  [[nodiscard]] bool bytes(std::size_t n, std::string_view& out, std::string&) noexcept {
+    if(data.size() - pos < n) return false;
+    out = data.substr(pos, n);
+    pos += n;
+    return true;
+  }
+};
+
+// same reads from any istream-like source, text goes through one reused buffer.
+template<typename In>
+struct StreamSource {
+  In& in;
+
+  [[nodiscard]] bool done() noexcept { return in.peek() == In::traits_type::eof(); }
+
+  [[nodiscard]] bool byte(std::uint8_t& out) noexcept {
+    const auto c = in.get();
+    if(c == In::traits_type::eof()) return false;
+    out = static_cast<std::uint8_t>(c);
+    return true;
+  }
+
+  // `n` comes from the recording itself, so the buffer only grows as far as the data
+  // actually goes: a corrupt length fails at the end of the stream instead of allocating it.
+  [[nodiscard]] bool bytes(std::size_t n, std::string_view& out, std::string& scratch) noexcept {
+    constexpr std::size_t chunk = 1 << 16;
+    scratch.clear();
+
+    while(scratch.size() < n) {
+      const auto have = scratch.size();
+      const auto step = std::min(chunk, n - have);
+      scratch.resize(have + step);
+      if(!in.read(scratch.data() + have, static_cast<std::streamsize>(step))) return false;
+    }
+    out = scratch;
+    return true;
+  }
+};
+
+template<typename Source>
+[[nodiscard]] bool get_varint(Source& source, std::uint64_t& out) noexcept {
+  out = 0;
+  for(int shift = 0; shift < 64; shift += 7) {
+    std::uint8_t byte;
+    if(!source.byte(byte)) return false;
+    out |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+template<typename Source>
+[[nodiscard]] bool get_color(Source& source, Color& out) noexcept {
+  std::uint8_t kind, r = 0, g = 0, b = 0;
+  if(!source.byte(kind) || kind > static_cast<std::uint8_t>(ColorKind::Direct)) return false;
+
+  out = {};
+  out.kind = static_cast<ColorKind>(kind);
+  if(out.kind == ColorKind::Basic || out.kind == ColorKind::Indexed) {
+    if(!source.byte(r)) return false;
+  } else if(out.kind == ColorKind::Direct) {
+    if(!source.byte(r) || !source.byte(g) || !source.byte(b)) return false;
+  }
+
+  out.r = r; out.g = g; out.b = b;
+  return true;
+}
+
+// calls handler(const Attributes&, std::string_view) for every text record, in order.
+template<typename Source, typename Handler>
+[[nodiscard]] bool read_records(Source& source, Handler&& handler) noexcept {
+  std::string scratch;
+  std::string_view view;
+
+  if(!source.bytes(magic.size(), view, scratch) || view != magic)
+    return false;
+
+  std::vector<Attributes> styles;
+  Attributes current {};
+
+  while(!source.done()) {
+    std::uint8_t tag;
+    if(!source.byte(tag)) return false;
+
+    switch(tag) {
+      case DefineStyle: {
+        Attributes attributes {};
+        if(!source.byte(attributes.styles) || !get_color(source, attributes.foreground) ||
+           !get_color(source, attributes.background))
+          return false;
+        styles.push_back(attributes);
+        break;
+      }
+      case UseStyle: {
+        std::uint64_t id;
+        if(!get_varint(source, id) || id >= styles.size()) return false;
+        current = styles[id];
+        break;
+      }
+      case Text: {
+        std::uint64_t length;
+        if(!get_varint(source, length) || !source.bytes(length, view, scratch)) return false;
+        handler(static_cast<const Attributes&>(current), view);
+        break;
+      }
+      default: return false;
+    }
+  }
+  return true;
+}
+} // namespace detail
+
+// writes a recording to `stream`. styled text comes in either already split into attributes
+// and text (write), as raw colored output (feed), or through operator<< like any other stream,
+// so the print family can record into it directly. text runs in the same style are merged.
+template<typename Stream>
+class Recorder {
+public:
+  explicit Recorder(Stream& stream, std::size_t flush_threshold = 1 << 16) noexcept
+    : stream{stream}, flush_threshold{flush_threshold} {
+    buffer += magic;
+  }
+
+  Recorder(const Recorder&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+
+  ~Recorder() { finish(); }
+
+  void write(const Attributes& attributes, std::string_view text) noexcept {
+    if(text.empty())
+      return;
+
+    if(attributes != pending_style) {
+      flush_text();
+      pending_style = attributes;
+    }
+
+    pending += text;
+    if(pending.size() >= flush_threshold)
+      flush_text();
+  }
+
+  // raw output with escapes, decoded on the fly; may be split anywhere.
+  void feed(std::string_view raw) noexcept {
+    decoder.feed(raw,
+      [this](std::string_view text) { write(decoder.attributes(), text); },
+      [](const Attributes&) {});
+  }
+
+  template<typename T>
+  requires std::is_convertible_v<const T&, std::string_view> || Arithmetic<T>
+  Recorder& operator<<(const T& value) noexcept {
+    if constexpr(std::is_convertible_v<const T&, std::string_view>) {
+      feed(std::string_view{value});
+    } else if constexpr(std::is_same_v<T, char>) {
+      feed(std::string_view{&value, 1});
+    } else if constexpr(std::is_same_v<T, bool>) {
+      feed(value ? "true" : "false");
+    } else {
+      char digits[64];
+      const auto [end, ec] = std::to_chars(digits, digits + sizeof digits, value);
+      feed(std::string_view{digits, static_cast<std::size_t>(end - digits)});
+    }
+    return *this;
+  }
+
+  // writes out whatever is still buffered. the recording stays open for more output.
+  void finish() noexcept {
+    flush_text();
+    flush();
+  }
+
+private:
+  void flush_text() noexcept {
+    if(pending.empty())
+      return;
+
+    if(pending_style != written_style) {
+      auto [it, inserted] = ids.try_emplace(pending_style, ids.size());
+      if(inserted) {
+        buffer += static_cast<char>(DefineStyle);
+        buffer += static_cast<char>(pending_style.styles);
+        detail::put_color(buffer, pending_style.foreground);
+        detail::put_color(buffer, pending_style.background);
+      }
+
+      buffer += static_cast<char>(UseStyle);
+      detail::put_varint(buffer, it->second);
+      written_style = pending_style;
+    }
+
+    buffer += static_cast<char>(Text);
+    detail::put_varint(buffer, pending.size());
+    buffer += pending;
+    pending.clear();
+
+    if(buffer.size() >= flush_threshold)
+      flush();
+  }
+
+  void flush() noexcept {
+    if(buffer.empty())
+      return;
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+  }
+
+  Stream& stream;
+  std::size_t flush_threshold;
+  AnsiDecoder decoder;
+  std::unordered_map<Attributes, std::size_t> ids;
+  std::string buffer, pending;
+  Attributes pending_style {}, written_style {};
+};
+
+// calls handler(const Attributes&, std::string_view) for every text run of a recording held in memory.
+// false when the recording is malformed or truncated; runs before that point are already delivered.
+template<typename Handler>
+[[nodiscard]] bool replay(std::string_view recording, Handler&& handler) noexcept {
+  detail::MemorySource source { recording };
+  return detail::read_records(source, std::forward<Handler>(handler));
+}
+
+// same, reading from an istream-like source one record at a time.
+template<typename In, typename Handler>
+requires requires(In& in) { in.get(); in.peek(); }
+[[nodiscard]] bool replay(In& in, Handler&& handler) noexcept {
+  detail::StreamSource<In> source { in };
+  return detail::read_records(source, std::forward<Handler>(handler));
+}
+
+// replays as colored output for a terminal of the given depth. only the difference between
+// consecutive styles is written, Plain gives the bare text.
+template<typename Recording, typename Stream>
+[[nodiscard]] bool replay_to(Recording&& recording, Stream& stream,
+                                    color::ColorDepth depth = color::ColorDepth::Direct) noexcept {
+  Attributes current {};
+
+  const bool ok = replay(std::forward<Recording>(recording), [&](const Attributes& attributes, std::string_view text) {
+    const auto target = color::downsample(attributes, depth);
+    stream << colorized::detail::transition(current, target).view() << text;
+    current = target;
+  });
+
+  stream << colorized::detail::transition(current, {}).view();
+  return ok;
+}
+} // namespace colorized::record
+
+#if COLORIZED_DEFINITIONS
+namespace colorized::record {
+namespace detail {
+COLORIZED_INLINE void put_varint(std::string& out, std::uint64_t n) noexcept {
+  for(; n >= 0x80; n >>= 7)
+    out += static_cast<char>((n & 0x7f) | 0x80);
+  out += static_cast<char>(n);
+}
+
+COLORIZED_INLINE void put_color(std::string& out, const Color& color) noexcept {
+  out += static_cast<char>(color.kind);
+  switch(color.kind) {
+    case ColorKind::Basic:
+    case ColorKind::Indexed: out += static_cast<char>(color.r); break;
+    case ColorKind::Direct: {
+      out += static_cast<char>(color.r);
+      out += static_cast<char>(color.g);
+      out += static_cast<char>(color.b);
+      break;
+    }
+    default: break;
+  }
+}
+} // namespace detail
+} // namespace colorized::record
+#endif // COLORIZED_DEFINITIONS
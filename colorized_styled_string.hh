@@ -0,0 +1,396 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized.hh"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace colorized {
+namespace detail {
+// vector of trivially copyable values with room for N of them inside the object itself.
+template<typename T, std::size_t N>
+requires std::is_trivially_copyable_v<T>
+class SmallVector {
+public:
+  SmallVector() noexcept = default;
+
+  SmallVector(const SmallVector& other) noexcept { append(other.data(), other.size()); }
+
+  SmallVector(SmallVector&& other) noexcept { steal(other); }
+
+  SmallVector& operator=(const SmallVector& other) noexcept {
+    if(this != &other) {
+      clear();
+      append(other.data(), other.size());
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if(this != &other) {
+      release();
+      steal(other);
+    }
+    return *this;
+  }
+
+  ~SmallVector() { release(); }
+
+  [[nodiscard]] T* data() noexcept { return heap ? heap : local; }
+  [[nodiscard]] const T* data() const noexcept { return heap ? heap : local; }
+  [[nodiscard]] std::size_t size() const noexcept { return count; }
+  [[nodiscard]] bool empty() const noexcept { return count == 0; }
+  [[nodiscard]] bool is_inline() const noexcept { return heap == nullptr; }
+
+  T& operator[](std::size_t i) noexcept { return data()[i]; }
+  const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+  T& back() noexcept { return data()[count - 1]; }
+  const T& back() const noexcept { return data()[count - 1]; }
+
+  void clear() noexcept { count = 0; }
+
+  void reserve(std::size_t n) noexcept {
+    if(n > capacity)
+      reallocate(n, nullptr, 0);
+  }
+
+  // `values` may point into this vector itself.
+  void append(const T* values, std::size_t n) noexcept {
+    if(count + n > capacity)
+      reallocate(std::max(count + n, capacity * 2), values, n);
+    else
+      std::memcpy(data() + count, values, n * sizeof(T));
+    count += n;
+  }
+
+  void push_back(const T& value) noexcept { append(&value, 1); }
+
+  void insert(std::size_t pos, const T& value) noexcept {
+    const T copy = value; // may be one of our own elements, gone after a reallocation.
+    if(count + 1 > capacity)
+      reserve(capacity * 2);
+    std::memmove(data() + pos + 1, data() + pos, (count - pos) * sizeof(T));
+    data()[pos] = copy;
+    ++count;
+  }
+
+  void erase(std::size_t first, std::size_t last) noexcept {
+    std::memmove(data() + first, data() + last, (count - last) * sizeof(T));
+    count -= last - first;
+  }
+
+private:
+  // moves to a buffer of `n` elements, then appends `extra_count` values from `extra`; the old
+  // storage is freed last, so `extra` may point into it.
+  void reallocate(std::size_t n, const T* extra, std::size_t extra_count) noexcept {
+    auto* grown = new T[n];
+    std::memcpy(grown, data(), count * sizeof(T));
+    if(extra_count != 0)
+      std::memcpy(grown + count, extra, extra_count * sizeof(T));
+    delete[] heap;
+    heap = grown;
+    capacity = n;
+  }
+
+  void release() noexcept {
+    delete[] heap;
+    heap = nullptr;
+    capacity = N;
+    count = 0;
+  }
+
+  void steal(SmallVector& other) noexcept {
+    if(other.heap) {
+      heap = other.heap;
+      capacity = other.capacity;
+      count = other.count;
+      other.heap = nullptr;
+      other.capacity = N;
+      other.count = 0;
+    } else {
+      append(other.local, other.count);
+      other.count = 0;
+    }
+  }
+
+  T local[N];
+  T* heap { nullptr };
+  std::size_t count { 0 };
+  std::size_t capacity { N };
+};
+
+// process wide style interning: an attribute set becomes a 32 bit id that is stable for the
+// life of the program. entries are never moved, so lookups don't lock. id 0 is always {}.
+class StyleTable {
+public:
+  static constexpr std::uint32_t chunk_size = 1024;
+  static constexpr std::uint32_t max_chunks = 1024;
+
+  [[nodiscard]] std::uint32_t intern(const Attributes& attributes) noexcept;
+
+  [[nodiscard]] const Attributes& operator[](std::uint32_t id) const noexcept {
+    return chunks[id / chunk_size].load(std::memory_order_acquire)[id % chunk_size];
+  }
+
+  StyleTable() noexcept {
+    storage[0] = std::make_unique<Attributes[]>(chunk_size);
+    chunks[0].store(storage[0].get(), std::memory_order_release);
+  }
+
+private:
+  std::array<std::atomic<Attributes*>, max_chunks> chunks {};
+  std::array<std::unique_ptr<Attributes[]>, max_chunks> storage {};
+  std::unordered_map<Attributes, std::uint32_t> ids;
+  std::uint32_t count { 1 };
+  std::mutex mutex;
+};
+
+// never `static`: ids have to mean the same thing in every translation unit, so there is exactly one table.
+[[nodiscard]] COLORIZED_INLINE StyleTable& style_table() noexcept;
+} // namespace detail
+
+// text plus style runs, kept apart: the bytes live in one contiguous buffer and the runs in
+// two parallel arrays (start offset, interned style id). a run ends where the next one starts.
+// short strings with a few runs never touch the heap. escapes only exist while rendering,
+// so concatenating, slicing and restyling are plain memory operations.
+class StyledString {
+public:
+  struct Run {
+    std::size_t offset;
+    std::size_t length;
+    const Attributes& attributes;
+  };
+
+  StyledString() noexcept = default;
+
+  StyledString(std::string_view text, const Attributes& attributes = {}) noexcept {
+    append(text, attributes);
+  }
+
+  template<typename T>
+  requires std::is_convertible_v<const std::remove_reference_t<T>&, std::string_view>
+  StyledString(const Styled<T>& styled) noexcept {
+    append(std::string_view{styled.value}, styled.attributes);
+  }
+
+  // decodes colored output back into text and runs.
+  [[nodiscard]] static StyledString parse(std::string_view ansi) noexcept {
+    StyledString result;
+    AnsiDecoder decoder;
+    decoder.feed(ansi,
+      [&](std::string_view text) { result.append(text, decoder.attributes()); },
+      [](const Attributes&) {});
+    return result;
+  }
+
+  [[nodiscard]] std::string_view text() const noexcept { return {bytes.data(), bytes.size()}; }
+  [[nodiscard]] std::size_t size() const noexcept { return bytes.size(); }
+  [[nodiscard]] bool empty() const noexcept { return bytes.empty(); }
+  [[nodiscard]] std::size_t run_count() const noexcept { return starts.size(); }
+
+  [[nodiscard]] Run run(std::size_t i) const noexcept {
+    return {starts[i], run_end(i) - starts[i], detail::style_table()[styles[i]]};
+  }
+
+  StyledString& append(std::string_view text, const Attributes& attributes = {}) noexcept {
+    return append_run(text, detail::style_table().intern(attributes));
+  }
+
+  StyledString& append(const StyledString& other) noexcept {
+    // same table everywhere, so runs are copied as they are. `other` may be *this: sizes are
+    // taken up front and nothing reallocates while its bytes are being read.
+    const auto length = other.size();
+    const auto runs = other.run_count();
+    bytes.reserve(size() + length);
+    starts.reserve(run_count() + runs);
+    styles.reserve(run_count() + runs);
+
+    for(std::size_t i = 0; i < runs; ++i) {
+      const std::size_t end = i + 1 < runs ? other.starts[i + 1] : length;
+      append_run(std::string_view{other.bytes.data() + other.starts[i], end - other.starts[i]}, other.styles[i]);
+    }
+    return *this;
+  }
+
+  StyledString& operator+=(const StyledString& other) noexcept { return append(other); }
+
+  friend StyledString operator+(StyledString lhs, const StyledString& rhs) noexcept {
+    lhs += rhs;
+    return lhs;
+  }
+
+  // bytes [pos, pos + length) with their runs; clamped to the string like std::string::substr.
+  [[nodiscard]] StyledString substr(std::size_t pos, std::size_t length = std::string_view::npos) const noexcept {
+    StyledString result;
+    pos = std::min(pos, size());
+    const auto end = pos + std::min(length, size() - pos);
+
+    for(std::size_t i = find_run(pos); i < run_count() && starts[i] < end; ++i) {
+      const auto first = std::max<std::size_t>(starts[i], pos);
+      const auto last = std::min(run_end(i), end);
+      result.append_run(text().substr(first, last - first), styles[i]);
+    }
+    return result;
+  }
+
+  // replaces the style of [pos, pos + length).
+  StyledString& restyle(std::size_t pos, std::size_t length, const Attributes& attributes) noexcept {
+    const auto id = detail::style_table().intern(attributes);
+    return update(pos, length, [id](std::uint32_t) { return id; });
+  }
+
+  // merges `attributes` on top of whatever [pos, pos + length) already has, like nesting Styled values.
+  StyledString& apply(std::size_t pos, std::size_t length, const Attributes& attributes) noexcept {
+    return update(pos, length, [&attributes](std::uint32_t id) {
+      return detail::style_table().intern(detail::style_table()[id].merge(attributes));
+    });
+  }
+
+  // only the difference between neighbouring runs is written, plus one reset at the end.
+  template<std::output_iterator<char> Out>
+  Out render_to(Out out) const noexcept {
+    Attributes current {};
+    for(std::size_t i = 0; i < run_count(); ++i) {
+      const auto& attributes = detail::style_table()[styles[i]];
+      out = detail::copy_to(out, detail::transition(current, attributes).view());
+      out = detail::copy_to(out, text().substr(starts[i], run_end(i) - starts[i]));
+      current = attributes;
+    }
+    return detail::copy_to(out, detail::transition(current, {}).view());
+  }
+
+  void render_to(std::string& buffer) const noexcept { render_to(std::back_inserter(buffer)); }
+
+  template<typename Stream>
+  requires requires(Stream& stream, std::string_view str) { stream << str; }
+  friend Stream& operator<<(Stream& stream, const StyledString& str) noexcept {
+    Attributes current {};
+    for(std::size_t i = 0; i < str.run_count(); ++i) {
+      const auto& attributes = detail::style_table()[str.styles[i]];
+      stream << detail::transition(current, attributes).view()
+             << str.text().substr(str.starts[i], str.run_end(i) - str.starts[i]);
+      current = attributes;
+    }
+    stream << detail::transition(current, {}).view();
+    return stream;
+  }
+
+  [[nodiscard]] bool operator==(const StyledString& other) const noexcept {
+    return text() == other.text() && run_count() == other.run_count() &&
+           std::equal(starts.data(), starts.data() + starts.size(), other.starts.data()) &&
+           std::equal(styles.data(), styles.data() + styles.size(), other.styles.data());
+  }
+
+private:
+  [[nodiscard]] std::size_t run_end(std::size_t i) const noexcept {
+    return i + 1 < run_count() ? starts[i + 1] : size();
+  }
+
+  // run containing byte `pos`, run_count() when pos is at or past the end.
+  [[nodiscard]] std::size_t find_run(std::size_t pos) const noexcept {
+    const auto* first = starts.data();
+    const auto* it = std::upper_bound(first, first + starts.size(), static_cast<std::uint32_t>(pos));
+    return pos >= size() ? run_count() : static_cast<std::size_t>(it - first) - 1;
+  }
+
+  StyledString& append_run(std::string_view text, std::uint32_t style) noexcept {
+    if(text.empty())
+      return *this;
+
+    if(styles.empty() || styles.back() != style) {
+      starts.push_back(static_cast<std::uint32_t>(size()));
+      styles.push_back(style);
+    }
+    bytes.append(text.data(), text.size());
+    return *this;
+  }
+
+  // makes `pos` a run boundary and returns the index of the run starting there.
+  std::size_t split_at(std::size_t pos) noexcept {
+    const auto i = find_run(pos);
+    if(i == run_count() || starts[i] == pos)
+      return i;
+
+    starts.insert(i + 1, static_cast<std::uint32_t>(pos));
+    styles.insert(i + 1, styles[i]);
+    return i + 1;
+  }
+
+  template<typename Restyle>
+  StyledString& update(std::size_t pos, std::size_t length, Restyle&& restyle) noexcept {
+    pos = std::min(pos, size());
+    const auto end = pos + std::min(length, size() - pos);
+    if(pos == end)
+      return *this;
+
+    const auto first = split_at(pos);
+    const auto last = split_at(end);
+    for(std::size_t i = first; i < last; ++i)
+      styles[i] = restyle(styles[i]);
+
+    // neighbours that ended up with the same style become one run again.
+    const auto lo = first == 0 ? 1 : first;
+    for(std::size_t i = std::min(last, run_count() - 1); i >= lo; --i) {
+      if(styles[i] == styles[i - 1]) {
+        starts.erase(i, i + 1);
+        styles.erase(i, i + 1);
+      }
+    }
+    return *this;
+  }
+
+  detail::SmallVector<char, 32> bytes;
+  detail::SmallVector<std::uint32_t, 4> starts;
+  detail::SmallVector<std::uint32_t, 4> styles;
+};
+} // namespace colorized
+
+#if COLORIZED_DEFINITIONS
+namespace colorized::detail {
+[[nodiscard]] COLORIZED_INLINE std::uint32_t StyleTable::intern(const Attributes& attributes) noexcept {
+  if(attributes == Attributes{})
+    return 0;
+
+  // the same style is usually interned many times in a row.
+  thread_local Attributes last_attributes {};
+  thread_local std::uint32_t last_id = 0;
+  if(last_id != 0 && last_attributes == attributes)
+    return last_id;
+
+  std::lock_guard lock { mutex };
+  auto [it, inserted] = ids.try_emplace(attributes, count);
+
+  if(inserted) {
+    if(count == chunk_size * max_chunks) {
+      ids.erase(it);
+      return 0; // table full, extra styles degrade to unstyled.
+    }
+
+    auto& chunk = chunks[count / chunk_size];
+    if(chunk.load(std::memory_order_relaxed) == nullptr) {
+      storage[count / chunk_size] = std::make_unique<Attributes[]>(chunk_size);
+      chunk.store(storage[count / chunk_size].get(), std::memory_order_release);
+    }
+    chunk.load(std::memory_order_relaxed)[count % chunk_size] = attributes;
+    ++count;
+  }
+
+  last_attributes = attributes;
+  last_id = it->second;
+  return it->second;
+}
+
+[[nodiscard]] COLORIZED_INLINE StyleTable& style_table() noexcept {
+  static StyleTable table;
+  return table;
+}
+} // namespace colorized::detail
+#endif // COLORIZED_DEFINITIONS
@@ -0,0 +1,240 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+#pragma once
+
+#include "colorized_config.hh"
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace colorized::unicode {
+inline constexpr char32_t replacement_character = U'�';
+
+// decodes the code point at `pos` and moves `pos` past it. malformed or truncated
+// sequences give U+FFFD and consume a single byte, so decoding always makes progress.
+[[nodiscard]] constexpr char32_t next(std::string_view text, std::size_t& pos) noexcept {
+  const auto lead = static_cast<unsigned char>(text[pos++]);
+
+  if(lead < 0x80)
+    return lead;
+
+  std::size_t length = 0;
+  char32_t cp = 0;
+
+  if((lead & 0xe0) == 0xc0) { length = 1; cp = lead & 0x1f; }
+  else if((lead & 0xf0) == 0xe0) { length = 2; cp = lead & 0x0f; }
+  else if((lead & 0xf8) == 0xf0) { length = 3; cp = lead & 0x07; }
+  else return replacement_character;
+
+  if(pos + length > text.size())
+    return replacement_character;
+
+  for(std::size_t i = 0; i < length; ++i) {
+    const auto c = static_cast<unsigned char>(text[pos + i]);
+    if((c & 0xc0) != 0x80)
+      return replacement_character;
+    cp = cp << 6 | (c & 0x3f);
+  }
+
+  pos += length;
+  return cp;
+}
+
+// code points that never start a cluster of their own: combining marks, variation
+// selectors, emoji skin tone modifiers, tags and the joiners.
+[[nodiscard]] constexpr bool is_extending(char32_t cp) noexcept {
+  return (cp >= 0x0300 && cp <= 0x036f) || (cp >= 0x0483 && cp <= 0x0489) || (cp >= 0x0591 && cp <= 0x05bd) ||
+         (cp >= 0x0610 && cp <= 0x061a) || (cp >= 0x064b && cp <= 0x065f) || (cp >= 0x0e31 && cp <= 0x0e3a) ||
+         (cp >= 0x1ab0 && cp <= 0x1aff) || (cp >= 0x1dc0 && cp <= 0x1dff) || (cp >= 0x200c && cp <= 0x200d) ||
+         (cp >= 0x20d0 && cp <= 0x20ff) || (cp >= 0xfe00 && cp <= 0xfe0f) || (cp >= 0xfe20 && cp <= 0xfe2f) ||
+         (cp >= 0x1f3fb && cp <= 0x1f3ff) || (cp >= 0xe0020 && cp <= 0xe007f) || (cp >= 0xe0100 && cp <= 0xe01ef);
+}
+
+[[nodiscard]] constexpr bool is_regional_indicator(char32_t cp) noexcept {
+  return cp >= 0x1f1e6 && cp <= 0x1f1ff;
+}
+
+// end of the grapheme cluster starting at `pos`. this is the practical subset of UAX #29
+// terminals care about: CR LF, combining sequences, ZWJ emoji sequences and flag pairs.
+[[nodiscard]] constexpr std::size_t next_grapheme(std::string_view text, std::size_t pos) noexcept {
+  if(pos >= text.size())
+    return text.size();
+
+  const char32_t first = next(text, pos);
+  char32_t previous = first;
+
+  if(first == U'\r' && pos < text.size() && text[pos] == '\n')
+    return pos + 1;
+
+  while(pos < text.size()) {
+    std::size_t peek = pos;
+    const char32_t cp = next(text, peek);
+
+    const bool joined = previous == 0x200d && cp > 0x7f;
+    const bool flag = is_regional_indicator(first) && is_regional_indicator(cp) && previous == first;
+
+    if(!is_extending(cp) && !joined && !flag)
+      break;
+
+    previous = cp;
+    pos = peek;
+  }
+  return pos;
+}
+
+namespace detail {
+struct Range {
+  char32_t first, last;
+};
+
+// East Asian Wide and Fullwidth blocks plus emoji with default emoji presentation, merged
+// where the gaps don't matter for terminals. sorted, searched with a binary search.
+inline constexpr Range wide_ranges[] {
+  {0x1100, 0x115f}, {0x231a, 0x231b}, {0x2329, 0x232a}, {0x23e9, 0x23ec}, {0x23f0, 0x23f0},
+  {0x23f3, 0x23f3}, {0x25fd, 0x25fe}, {0x2614, 0x2615}, {0x2648, 0x2653}, {0x267f, 0x267f},
+  {0x2693, 0x2693}, {0x26a1, 0x26a1}, {0x26aa, 0x26ab}, {0x26bd, 0x26be}, {0x26c4, 0x26c5},
+  {0x26ce, 0x26ce}, {0x26d4, 0x26d4}, {0x26ea, 0x26ea}, {0x26f2, 0x26f3}, {0x26f5, 0x26f5},
+  {0x26fa, 0x26fa}, {0x26fd, 0x26fd}, {0x2705, 0x2705}, {0x270a, 0x270b}, {0x2728, 0x2728},
+  {0x274c, 0x274c}, {0x274e, 0x274e}, {0x2753, 0x2755}, {0x2757, 0x2757}, {0x2795, 0x2797},
+  {0x27b0, 0x27b0}, {0x27bf, 0x27bf}, {0x2b1b, 0x2b1c}, {0x2b50, 0x2b50}, {0x2b55, 0x2b55},
+  {0x2e80, 0x303e}, {0x3041, 0x33ff}, {0x3400, 0x4dbf}, {0x4e00, 0x9fff}, {0xa000, 0xa4cf},
+  {0xa960, 0xa97f}, {0xac00, 0xd7a3}, {0xf900, 0xfaff}, {0xfe10, 0xfe19}, {0xfe30, 0xfe6f},
+  {0xff00, 0xff60}, {0xffe0, 0xffe6}, {0x16fe0, 0x16fe4}, {0x17000, 0x18cff}, {0x1aff0, 0x1b2ff},
+  {0x1f004, 0x1f004}, {0x1f0cf, 0x1f0cf}, {0x1f18e, 0x1f18e}, {0x1f191, 0x1f19a}, {0x1f200, 0x1f202},
+  {0x1f210, 0x1f23b}, {0x1f240, 0x1f248}, {0x1f250, 0x1f251}, {0x1f260, 0x1f265}, {0x1f300, 0x1f320},
+  {0x1f32d, 0x1f335}, {0x1f337, 0x1f37c}, {0x1f37e, 0x1f393}, {0x1f3a0, 0x1f3ca}, {0x1f3cf, 0x1f3d3},
+  {0x1f3e0, 0x1f3f0}, {0x1f3f4, 0x1f3f4}, {0x1f3f8, 0x1f43e}, {0x1f440, 0x1f440}, {0x1f442, 0x1f4fc},
+  {0x1f4ff, 0x1f53d}, {0x1f54b, 0x1f54e}, {0x1f550, 0x1f567}, {0x1f57a, 0x1f57a}, {0x1f595, 0x1f596},
+  {0x1f5a4, 0x1f5a4}, {0x1f5fb, 0x1f64f}, {0x1f680, 0x1f6c5}, {0x1f6cc, 0x1f6cc}, {0x1f6d0, 0x1f6d2},
+  {0x1f6d5, 0x1f6d7}, {0x1f6dc, 0x1f6df}, {0x1f6eb, 0x1f6ec}, {0x1f6f4, 0x1f6fc}, {0x1f7e0, 0x1f7eb},
+  {0x1f7f0, 0x1f7f0}, {0x1f90c, 0x1f93a}, {0x1f93c, 0x1f945}, {0x1f947, 0x1f9ff}, {0x1fa70, 0x1faff},
+  {0x20000, 0x2fffd}, {0x30000, 0x3fffd}
+};
+
+// format characters and Hangul medial/final jamo, on top of what is_extending already covers.
+inline constexpr Range zero_ranges[] {
+  {0x00ad, 0x00ad}, {0x1160, 0x11ff}, {0x200b, 0x200f}, {0x2028, 0x202e}, {0x2060, 0x2064},
+  {0xd7b0, 0xd7ff}, {0xfeff, 0xfeff}
+};
+
+template<std::size_t N>
+[[nodiscard]] constexpr bool contains(const Range (&ranges)[N], char32_t cp) noexcept {
+  if(cp < ranges[0].first || cp > ranges[N - 1].last)
+    return false;
+
+  const auto* it = std::upper_bound(ranges, ranges + N, cp, [](char32_t value, const Range& range) {
+    return value < range.first;
+  });
+  return it != ranges && cp <= (it - 1)->last;
+}
+
+// bytes [first, first + 16) are all printable ascii, one column each.
+[[nodiscard]] COLORIZED_INLINE bool printable_block(const char* first) noexcept;
+
+// position right after the escape sequence starting at `pos` (which holds ESC).
+[[nodiscard]] constexpr std::size_t skip_escape(std::string_view text, std::size_t pos) noexcept {
+  if(++pos >= text.size())
+    return pos;
+
+  if(text[pos] == '[') {
+    while(++pos < text.size())
+      if(static_cast<unsigned char>(text[pos]) >= 0x40 && static_cast<unsigned char>(text[pos]) <= 0x7e)
+        return pos + 1;
+    return pos;
+  }
+
+  if(text[pos] == ']') {
+    while(++pos < text.size()) {
+      if(text[pos] == '\x07') return pos + 1;
+      if(text[pos] == '\x1b') return std::min(pos + 2, text.size());
+    }
+    return pos;
+  }
+  return pos + 1;
+}
+} // namespace detail
+
+// terminal columns taken by one code point: 0 for controls, combining marks and format
+// characters, 2 for wide and fullwidth ones, 1 otherwise.
+[[nodiscard]] constexpr int width(char32_t cp) noexcept {
+  if(cp < 0x7f)
+    return cp >= 0x20 ? 1 : 0;
+  if(cp < 0xa0)
+    return 0;
+  if(is_extending(cp) || detail::contains(detail::zero_ranges, cp))
+    return 0;
+  return detail::contains(detail::wide_ranges, cp) ? 2 : 1;
+}
+
+// columns taken by the grapheme cluster [pos, end): its first code point decides,
+// except that an emoji presentation selector always makes it two columns wide.
+[[nodiscard]] constexpr int grapheme_width(std::string_view text, std::size_t pos, std::size_t end) noexcept {
+  const int first = width(next(text, pos));
+  if(first == 2)
+    return 2;
+
+  while(pos < end)
+    if(next(text, pos) == 0xfe0f)
+      return 2;
+  return first;
+}
+
+// display width of `text` in columns. escape sequences count as nothing, runs of plain
+// ascii are measured 16 bytes at a time.
+[[nodiscard]] COLORIZED_INLINE std::size_t display_width(std::string_view text) noexcept;
+} // namespace colorized::unicode
+
+#if COLORIZED_DEFINITIONS
+namespace colorized::unicode {
+namespace detail {
+[[nodiscard]] COLORIZED_INLINE bool printable_block(const char* first) noexcept {
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+  // signed compares, so bytes >= 0x80 fail the first test as well.
+  const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(0x1f)),
+                                          _mm_cmplt_epi8(block, _mm_set1_epi8(0x7f)));
+  return _mm_movemask_epi8(printable) == 0xffff;
+#else
+  for(int i = 0; i < 16; ++i)
+    if(static_cast<unsigned char>(first[i]) < 0x20 || static_cast<unsigned char>(first[i]) >= 0x7f)
+      return false;
+  return true;
+#endif
+}
+} // namespace detail
+
+[[nodiscard]] COLORIZED_INLINE std::size_t display_width(std::string_view text) noexcept {
+  std::size_t columns = 0, pos = 0;
+
+  while(pos < text.size()) {
+    if(text.size() - pos >= 16 && detail::printable_block(text.data() + pos)) {
+      columns += 16;
+      pos += 16;
+      continue;
+    }
+
+    const auto c = static_cast<unsigned char>(text[pos]);
+    if(c >= 0x20 && c < 0x7f) {
+      ++columns;
+      ++pos;
+    } else if(c == 0x1b) {
+      pos = detail::skip_escape(text, pos);
+    } else {
+      const auto end = next_grapheme(text, pos);
+      columns += static_cast<std::size_t>(grapheme_width(text, pos, end));
+      pos = end;
+    }
+  }
+  return columns;
+}
+} // namespace colorized::unicode
+#endif // COLORIZED_DEFINITIONS
@@ -27,6 +27,9 @@ int main() {
 		Pack{ Style::Bold, Foreground::FgBrBlue, Background::BgDefault, std::cout, "Hello world: {}\n"sv, 1 + 2 }
 	);
 
+	// lazily styled values, rendered in place with one sequence and one reset.
+	std::cout << "status: " << bold(fg(FgGreen, bg(BgBlack, str))) << ", code " << rgb(255, 0, 0)(42) << '\n';
+
 	print_cout_reset();
 
 	return 0;
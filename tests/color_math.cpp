@@ -0,0 +1,61 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+// color conversions and batch kernels with out of range or mismatched inputs.
+#include "colorized_color.hh"
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+using namespace colorized;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  if(!ok) {
+    std::fprintf(stderr, "failed: %s\n", what);
+    ++failures;
+  }
+}
+
+int main() {
+  // hues wrap in constant time, whatever their magnitude.
+  const RGBA red { 255, 0, 0 };
+  check(color::from_hsv({360 * 1048576.f, 1, 1}) == red, "large hue");
+  check(color::from_hsv({-360 * 7.f, 1, 1}) == red, "negative hue");
+  check(color::from_hsv({-1e-30f, 1, 1}) == red, "hue just below 0");
+  for(float h : {1e30f, -1e30f, std::numeric_limits<float>::max(), std::numeric_limits<float>::infinity(),
+                 std::numeric_limits<float>::quiet_NaN()}) {
+    const auto hsv = color::from_hsv({h, 1, 1});
+    const auto hsl = color::from_hsl({h, 1, 0.5f});
+    check(hsv.r + hsv.g + hsv.b >= 255 && hsl.r + hsl.g + hsl.b >= 255, "extreme hue gives a saturated color");
+  }
+  static_assert(color::from_hsv({720 + 120, 1, 1}) == RGBA{0, 255, 0});
+  static_assert(color::from_hsl({-240, 1, 0.5f}) == RGBA{0, 255, 0});
+  static_cast<void>(color::from_hsv({0, std::numeric_limits<float>::quiet_NaN(), 1})); // no UB on NaN channels
+
+  // batch kernels stop at the shortest input instead of reading past it.
+  {
+    std::vector<std::uint8_t> r(600, 7), g(600, 7), b(600, 7);
+    const std::vector<std::uint8_t> black(300, 0), white(500, 255);
+    const std::vector<float> t(400, 1.0f);
+    const color::MutablePlanes out { r, g, b };
+
+    color::blend({black, black, black}, {white, white, white}, t, out);
+    check(r[299] == 255 && r[300] == 7 && b[599] == 7, "blend clamps to the shortest span");
+
+    const std::vector<float> values(100, 1.0f);
+    const RGBA stops[] { {0, 0, 0}, {10, 20, 30} };
+    color::heat(values, 0, 1, stops, out);
+    check(r[99] == 10 && g[99] == 20 && r[100] == 255, "heat clamps to the values");
+
+    std::vector<std::uint8_t> short_b(50, 7);
+    color::gradient(stops, {r, g, short_b});
+    check(short_b[49] == 30 && r[0] == 0 && r[49] == 10 && g[50] == 20, "planes of different sizes");
+  }
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+// html::convert and Converter edge cases around the flush threshold.
+#include "colorized_html.hh"
+#include <cstdio>
+#include <sstream>
+
+using namespace colorized;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  if(!ok) {
+    std::fprintf(stderr, "failed: %s\n", what);
+    ++failures;
+  }
+}
+
+static bool ends_with(std::string_view str, std::string_view suffix) {
+  return str.size() >= suffix.size() && str.substr(str.size() - suffix.size()) == suffix;
+}
+
+int main() {
+  // a threshold of 0 flushes after every piece, convert() still has to read real chunks.
+  for(std::size_t threshold : {std::size_t{0}, std::size_t{1}, std::size_t{1} << 16}) {
+    std::istringstream in(std::string(100000, 'x') + "\x1b[1mbold<\x1b[0m");
+    std::ostringstream out;
+    html::Options options;
+    options.flush_threshold = threshold;
+
+    html::convert(in, out, options);
+    check(ends_with(out.str(), "<span class=\"c0\">bold&lt;</span></pre>\n"), "convert output");
+  }
+
+  // a converter that goes out of scope without finish() still writes and closes everything.
+  {
+    std::ostringstream out;
+    {
+      html::Converter<std::ostringstream> converter { out };
+      converter.feed("\x1b[31mred");
+    }
+    check(ends_with(out.str(), "red</span></pre>\n"), "destructor finishes");
+  }
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+// wrap() never hands out a line wider than asked for, and tables stay aligned with it.
+#include "colorized_layout.hh"
+#include <cstdio>
+#include <sstream>
+
+using namespace colorized;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  if(!ok) {
+    std::fprintf(stderr, "failed: %s\n", what);
+    ++failures;
+  }
+}
+
+int main() {
+  for(std::string_view text : {"ab      ", "ab cd      ", "a     b", "    ", "ab\n   "}) {
+    for(const auto& line : layout::wrap(StyledString{text}, 3))
+      check(layout::width(line) <= 3, "wrapped line fits");
+  }
+
+  {
+    const auto lines = layout::wrap(StyledString{"ab      "}, 3);
+    check(lines.size() == 1 && lines[0].text() == "ab", "trailing blanks dropped from the last line");
+  }
+
+  {
+    layout::Table table({{3, layout::Align::Left, layout::Overflow::Wrap}, {}}, "|");
+    table.add_row({StyledString{"ab      "}, StyledString{"x"}});
+    table.add_row({StyledString{"abc"}, StyledString{"y"}});
+
+    std::ostringstream out;
+    table.render(out);
+    check(out.str() == "ab |x\nabc|y\n", "separator stays aligned");
+  }
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+// progress bar rendering with counters far past what `count * 100` can hold in 64 bits.
+#include "colorized_live.hh"
+#include <cstdio>
+#include <limits>
+
+using namespace colorized;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  if(!ok) {
+    std::fprintf(stderr, "failed: %s\n", what);
+    ++failures;
+  }
+}
+
+static std::size_t count(std::string_view str, std::string_view piece) {
+  std::size_t n = 0;
+  for(auto pos = str.find(piece); pos != std::string_view::npos; pos = str.find(piece, pos + piece.size()))
+    ++n;
+  return n;
+}
+
+int main() {
+  constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+  static_assert(live::detail::proportion(max / 2, 100, max) == 49);
+  static_assert(live::detail::proportion(max, 100, max) == 100);
+  static_assert(live::detail::proportion(3, 10, 4) == 7);
+
+  const live::BarStyle style { {}, {}, {}, {}, 10 };
+  live::Bar bar { "copy", 4'000'000'000'000'000'000ull, style };
+  bar.set(3'000'000'000'000'000'000ull);
+
+  std::string line;
+  live::detail::render_bar(line, bar);
+  check(line.find(" 75%") != std::string::npos, "percentage of a huge counter");
+  check(count(line, "█") == 7 && count(line, "░") == 3, "bar of a huge counter");
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+// MIT License
+//
+// Copyright (c) 2024 Ferhat Geçdoğan All Rights Reserved.
+// Distributed under the terms of the MIT License.
+//
+
+// StyledString operations whose source aliases its own storage. built with address sanitizer
+// where the compiler has it, the use-after-free fails the test even when the output looks right.
+#include "colorized_styled_string.hh"
+#include <cstdio>
+
+using namespace colorized;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  if(!ok) {
+    std::fprintf(stderr, "failed: %s\n", what);
+    ++failures;
+  }
+}
+
+// 8 runs fill the inline run arrays, so the next split moves them to the heap.
+static StyledString eight_runs() {
+  StyledString str;
+  for(std::uint8_t i = 0; i < 8; ++i)
+    str.append("ab", {0, Color{static_cast<_8BitColor>(16 + i)}});
+  return str;
+}
+
+int main() {
+  {
+    auto str = eight_runs();
+    str.restyle(1, 1, {1u << Bold});
+    check(str.size() == 16 && str.run_count() == 9, "restyle across the inline capacity");
+    check(str.run(0).attributes == Attributes{0, Color{static_cast<_8BitColor>(16)}}, "restyle keeps the split run's style");
+    check(str.run(1).attributes == Attributes{1u << Bold}, "restyle sets the new style");
+  }
+
+  {
+    auto str = eight_runs();
+    str.apply(3, 10, {1u << Underline});
+    check(str.size() == 16 && str.run_count() == 10, "apply across the inline capacity");
+  }
+
+  {
+    StyledString str("0123456789", {1u << Bold});
+    str.append("0123456789012345678901234567890", {0, Color{FgRed}});
+    const auto copy = str;
+    str += str;
+    check(str.size() == 82 && str.substr(0, 41) == copy && str.substr(41) == copy, "self append");
+  }
+
+  {
+    detail::SmallVector<std::uint32_t, 4> values;
+    for(std::uint32_t i = 0; i < 4; ++i)
+      values.push_back(i);
+    values.push_back(values[0]);
+    values.insert(0, values[3]);
+    values.append(values.data(), values.size());
+    check(values.size() == 12 && values[0] == 3 && values[5] == 0 && values[6] == 3 && values[11] == 0,
+          "SmallVector values from its own storage");
+  }
+
+  return failures == 0 ? 0 : 1;
+}